@@ -0,0 +1,329 @@
+// Noise kernel microbenchmarks
+// Times the Perlin helpers, the legacy PerlinNoise/LayeredNoise wrappers, NoiseGenerator and
+// every LayeredRow kernel the CPU supports, and prints ns/sample as JSON. A golden-value check
+// runs first; the program exits with status 1 if any kernel no longer matches.
+//
+// Usage: noise_bench [--filter substring] [--min-time seconds]
+
+#include "GameConstants.h" // For CONTINENT_OCTAVES, TERRAIN_OCTAVES, RIVER_OCTAVES
+#include "Noise.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+const int kSampleCount = 4096; // Samples per benchmark iteration
+const int kSeed = 1;
+
+volatile float benchSink; // Keeps the measured results alive
+
+uint32_t FloatBits(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// Golden values
+// Recorded from the scalar implementation. Fade/Grad/Lerp are pure arithmetic and must match
+// everywhere. The Perlin and layered values depend on std::shuffle, whose output differs
+// between standard libraries, so they are only compared when the seed-1 permutation matches
+// the one they were recorded with.
+
+const uint64_t kGoldenPermutationHash = 0x5e04b1a14f653f05ull; // FNV-1a of BuildPermutation(1)[0..255]
+
+struct GoldenPerlin {
+    float x, y;
+    int seed;
+    uint32_t bits;
+};
+
+const GoldenPerlin kGoldenPerlin[] = {
+    {0.37f, 0.91f, 1, 0x3eb019c6u},
+    {12.5f, -3.25f, 7, 0xbde58000u},
+    {200.1f, 55.7f, 42, 0xbd22e920u},
+    {-71.3f, 300.2f, 3, 0xbe83320du},
+};
+
+struct GoldenLayered {
+    float x, y;
+    int octaves;
+    float persistence, scale;
+    int seed;
+    uint32_t bits;
+};
+
+const GoldenLayered kGoldenLayered[] = {
+    {0.3f, 0.7f, CONTINENT_OCTAVES, 0.6f, 0.5f, 1, 0xbdf51347u},
+    {0.42f, 0.13f, TERRAIN_OCTAVES, 0.5f, 2.0f, 2, 0x3e0b3cf0u},
+    {0.9f, 0.55f, RIVER_OCTAVES, 0.7f, 3.0f, 4, 0xbd9286ecu},
+    {5.3f, -2.6f, TERRAIN_OCTAVES, 0.5f, 2.0f, 1, 0x3e395b8cu},
+};
+
+std::vector<NoiseKernel> SupportedKernels() {
+    std::vector<NoiseKernel> kernels = {NoiseKernel::Scalar};
+    if (ActiveNoiseKernel() != NoiseKernel::Scalar) kernels.push_back(ActiveNoiseKernel());
+    return kernels;
+}
+
+bool CheckBits(const std::string& what, float actual, uint32_t expected) {
+    if (FloatBits(actual) == expected) return true;
+    std::cerr << "Golden mismatch: " << what << " = " << actual << " (0x" << std::hex << FloatBits(actual)
+              << ", expected 0x" << expected << std::dec << ")" << std::endl;
+    return false;
+}
+
+bool RunGoldenChecks() {
+    bool ok = true;
+    ok &= CheckBits("Fade(0.3125)", Fade(0.3125f), 0x3e385380u);
+    ok &= CheckBits("Grad(13, 0.25, -0.75)", Grad(13, 0.25f, -0.75f), 0x3f400000u);
+    ok &= CheckBits("Grad(6, 0.6, 0.2)", Grad(6, 0.6f, 0.2f), 0x3f19999au);
+    ok &= CheckBits("Lerp(-0.5, 0.75, 0.3)", Lerp(-0.5f, 0.75f, 0.3f), 0xbe000000u);
+
+    int permutation[512];
+    BuildPermutation(1, permutation);
+    uint64_t hash = 1469598103934665603ull;
+    for (int i = 0; i < 256; ++i) {
+        hash ^= static_cast<uint64_t>(permutation[i]);
+        hash *= 1099511628211ull;
+    }
+
+    const NoiseGenerator generator(1, 64);
+    if (hash == kGoldenPermutationHash) {
+        for (const GoldenPerlin& g : kGoldenPerlin) {
+            ok &= CheckBits("PerlinNoise", PerlinNoise(g.x, g.y, g.seed), g.bits);
+            ok &= CheckBits("NoiseGenerator::Perlin", generator.Perlin(g.x, g.y, g.seed), g.bits);
+        }
+        for (const GoldenLayered& g : kGoldenLayered) {
+            ok &= CheckBits("LayeredNoise", LayeredNoise(g.x, g.y, g.octaves, g.persistence, g.scale, g.seed), g.bits);
+            ok &= CheckBits("NoiseGenerator::Layered",
+                            generator.Layered(g.x, g.y, g.octaves, g.persistence, g.scale, g.seed), g.bits);
+        }
+    } else {
+        std::cerr << "Note: this standard library shuffles differently; Perlin golden values skipped" << std::endl;
+    }
+
+    // Batch kernels must match the scalar call bit for bit on every lane and the tail
+    std::vector<float> xs(kSampleCount + 3), out(xs.size());
+    for (size_t i = 0; i < xs.size(); ++i) xs[i] = -3.0f + i * 0.0137f;
+    for (NoiseKernel kernel : SupportedKernels()) {
+        for (int octaves : {RIVER_OCTAVES, CONTINENT_OCTAVES, TERRAIN_OCTAVES}) {
+            generator.LayeredRow(xs.data(), 0.61f, static_cast<int>(xs.size()), octaves, 0.5f, 2.0f, kSeed,
+                                 out.data(), kernel);
+            for (size_t i = 0; i < xs.size(); ++i) {
+                float expected = generator.Layered(xs[i], 0.61f, octaves, 0.5f, 2.0f, kSeed);
+                if (FloatBits(out[i]) != FloatBits(expected)) {
+                    CheckBits(std::string("LayeredRow/") + NoiseKernelName(kernel), out[i], FloatBits(expected));
+                    ok = false;
+                    break;
+                }
+            }
+        }
+    }
+    return ok;
+}
+
+// Benchmark runner
+// Each case processes kSampleCount samples per iteration. Iterations double until one
+// measurement takes at least minTime seconds, and the result is reported per sample.
+
+struct BenchCase {
+    std::string name;
+    std::function<void(int iterations)> run;
+};
+
+double MeasureNsPerSample(const BenchCase& bench, double minTime) {
+    bench.run(1); // Warm caches and the per-thread permutation table
+    for (int iterations = 1;; iterations *= 2) {
+        auto start = std::chrono::steady_clock::now();
+        bench.run(iterations);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (seconds >= minTime || iterations >= (1 << 24)) {
+            return seconds * 1e9 / (double(iterations) * kSampleCount);
+        }
+    }
+}
+
+// Sample coordinates: coherent walks a row in small steps the way world generation does,
+// random jumps across the whole 256x256 lattice so table lookups miss the cache pattern.
+struct Inputs {
+    std::vector<float> coherentX, coherentY, randomX, randomY, unit;
+    std::vector<int> hashes;
+};
+
+Inputs BuildInputs() {
+    Inputs in;
+    std::mt19937 gen(12345);
+    std::uniform_real_distribution<float> lattice(0.0f, 256.0f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::uniform_int_distribution<int> hash(0, 255);
+    for (int i = 0; i < kSampleCount; ++i) {
+        in.coherentX.push_back(i * 0.01f);
+        in.coherentY.push_back(0.5f + (i / 256) * 0.01f);
+        in.randomX.push_back(lattice(gen));
+        in.randomY.push_back(lattice(gen));
+        in.unit.push_back(unit(gen));
+        in.hashes.push_back(hash(gen));
+    }
+    return in;
+}
+
+std::vector<BenchCase> BuildCases(const Inputs& in, const NoiseGenerator& generator) {
+    std::vector<BenchCase> cases;
+
+    cases.push_back({"Fade", [&in](int iterations) {
+        float sum = 0.0f;
+        for (int it = 0; it < iterations; ++it)
+            for (int i = 0; i < kSampleCount; ++i) sum += Fade(in.unit[i]);
+        benchSink = sum;
+    }});
+    cases.push_back({"Grad", [&in](int iterations) {
+        float sum = 0.0f;
+        for (int it = 0; it < iterations; ++it)
+            for (int i = 0; i < kSampleCount; ++i) sum += Grad(in.hashes[i], in.unit[i], in.randomX[i]);
+        benchSink = sum;
+    }});
+    cases.push_back({"Lerp", [&in](int iterations) {
+        float sum = 0.0f;
+        for (int it = 0; it < iterations; ++it)
+            for (int i = 0; i < kSampleCount; ++i) sum += Lerp(in.randomX[i], in.randomY[i], in.unit[i]);
+        benchSink = sum;
+    }});
+
+    struct Access {
+        const char* name;
+        const std::vector<float>* xs;
+        const std::vector<float>* ys;
+    };
+    const Access accesses[] = {{"coherent", &in.coherentX, &in.coherentY}, {"random", &in.randomX, &in.randomY}};
+
+    for (const Access& access : accesses) {
+        const std::vector<float>& xs = *access.xs;
+        const std::vector<float>& ys = *access.ys;
+        cases.push_back({std::string("PerlinNoise/") + access.name, [&xs, &ys](int iterations) {
+            float sum = 0.0f;
+            for (int it = 0; it < iterations; ++it)
+                for (int i = 0; i < kSampleCount; ++i) sum += PerlinNoise(xs[i], ys[i], kSeed);
+            benchSink = sum;
+        }});
+        cases.push_back({std::string("NoiseGenerator::Perlin/") + access.name, [&xs, &ys, &generator](int iterations) {
+            float sum = 0.0f;
+            for (int it = 0; it < iterations; ++it)
+                for (int i = 0; i < kSampleCount; ++i) sum += generator.Perlin(xs[i], ys[i], kSeed);
+            benchSink = sum;
+        }});
+    }
+
+    // Alternating between four seeds: the legacy wrapper reshuffles its table on every call,
+    // the generator only picks a different prebuilt table
+    cases.push_back({"PerlinNoise/multi_seed", [&in](int iterations) {
+        float sum = 0.0f;
+        for (int it = 0; it < iterations; ++it)
+            for (int i = 0; i < kSampleCount; ++i) sum += PerlinNoise(in.coherentX[i], in.coherentY[i], kSeed + (i & 3));
+        benchSink = sum;
+    }});
+    cases.push_back({"NoiseGenerator::Perlin/multi_seed", [&in, &generator](int iterations) {
+        float sum = 0.0f;
+        for (int it = 0; it < iterations; ++it)
+            for (int i = 0; i < kSampleCount; ++i)
+                sum += generator.Perlin(in.coherentX[i], in.coherentY[i], kSeed + (i & 3));
+        benchSink = sum;
+    }});
+
+    struct Octaves {
+        const char* name;
+        int count;
+    };
+    const Octaves octaveCounts[] = {
+        {"RIVER_OCTAVES", RIVER_OCTAVES}, {"CONTINENT_OCTAVES", CONTINENT_OCTAVES}, {"TERRAIN_OCTAVES", TERRAIN_OCTAVES}};
+
+    for (const Octaves& octaves : octaveCounts) {
+        const int count = octaves.count;
+        for (const Access& access : accesses) {
+            const std::vector<float>& xs = *access.xs;
+            const std::vector<float>& ys = *access.ys;
+            const std::string suffix = std::string("/") + octaves.name + "/" + access.name;
+            cases.push_back({"LayeredNoise" + suffix, [&xs, &ys, count](int iterations) {
+                float sum = 0.0f;
+                for (int it = 0; it < iterations; ++it)
+                    for (int i = 0; i < kSampleCount; ++i) sum += LayeredNoise(xs[i], ys[i], count, 0.5f, 2.0f, kSeed);
+                benchSink = sum;
+            }});
+            cases.push_back({"NoiseGenerator::Layered" + suffix, [&xs, &ys, &generator, count](int iterations) {
+                float sum = 0.0f;
+                for (int it = 0; it < iterations; ++it)
+                    for (int i = 0; i < kSampleCount; ++i)
+                        sum += generator.Layered(xs[i], ys[i], count, 0.5f, 2.0f, kSeed);
+                benchSink = sum;
+            }});
+        }
+
+        // The row API only takes one y per call, so it is measured on coherent rows
+        for (NoiseKernel kernel : SupportedKernels()) {
+            cases.push_back({std::string("LayeredRow/") + NoiseKernelName(kernel) + "/" + octaves.name,
+                             [&in, &generator, count, kernel](int iterations) {
+                std::vector<float> out(kSampleCount);
+                float sum = 0.0f;
+                for (int it = 0; it < iterations; ++it) {
+                    generator.LayeredRow(in.coherentX.data(), 0.5f, kSampleCount, count, 0.5f, 2.0f, kSeed,
+                                         out.data(), kernel);
+                    sum += out[it % kSampleCount];
+                }
+                benchSink = sum;
+            }});
+        }
+    }
+    return cases;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string filter;
+    double minTime = 0.1;
+
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--filter") == 0 && hasValue) {
+            filter = argv[++i];
+        } else if (std::strcmp(argv[i], "--min-time") == 0 && hasValue) {
+            minTime = std::atof(argv[++i]);
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--filter substring] [--min-time seconds]" << std::endl;
+            return 1;
+        }
+    }
+
+    if (!RunGoldenChecks()) {
+        std::cerr << "Golden-value check failed" << std::endl;
+        return 1;
+    }
+
+    // Enough seeds for every octave of every layered case starting at kSeed
+    const NoiseGenerator generator(kSeed, TERRAIN_OCTAVES + 4);
+    const Inputs inputs = BuildInputs();
+    const std::vector<BenchCase> cases = BuildCases(inputs, generator);
+
+    std::cout << "{\n";
+    std::cout << "  \"noise_kernel\": \"" << NoiseKernelName(ActiveNoiseKernel()) << "\",\n";
+    std::cout << "  \"golden_check\": \"passed\",\n";
+    std::cout << "  \"samples_per_iteration\": " << kSampleCount << ",\n";
+    std::cout << "  \"benchmarks\": [";
+
+    bool first = true;
+    for (const BenchCase& bench : cases) {
+        if (!filter.empty() && bench.name.find(filter) == std::string::npos) continue;
+        std::cout << (first ? "\n" : ",\n");
+        std::cout << "    {\"name\": \"" << bench.name << "\", \"ns_per_sample\": " << MeasureNsPerSample(bench, minTime) << "}";
+        std::cout.flush();
+        first = false;
+    }
+    std::cout << "\n  ]\n}" << std::endl;
+    return 0;
+}
@@ -0,0 +1,280 @@
+// Headless world generation benchmark
+// Runs GenerateWorld for every size x thread count combination and prints one JSON document
+// with per-stage times, throughput and peak resident memory. No window is opened.
+//
+// Usage: worldgen_bench [--sizes 128,256,512] [--threads 1,2,4] [--repeat 5] [--compact] [--seed 1]
+//                       [--rays 20000]
+//   sizes are square world edges in tiles, threads 0 means one per hardware thread, and
+//   every combination reports the fastest of its repeats. --compact generates worlds
+//   without the color array. Each run reports WorldContentHash, which must not change
+//   with the thread count or storage, and matches between machines for the same seed.
+//   Before the runs, --rays random segments over a world of the first size are traced with
+//   ElevationPyramid::Raycast and with a tile-by-tile reference; any disagreement fails the
+//   bench. --rays 0 skips the check.
+
+#include "TerrainQuery.h"
+#include "World.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+struct BenchResult {
+    int size = 0;
+    unsigned threads = 0;
+    double totalMs = 0.0;
+    WorldGenTimings stages;
+    uint64_t contentHash = 0;
+    size_t worldBytes = 0;
+};
+
+std::vector<int> ParseList(const char* text) {
+    std::vector<int> values;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) values.push_back(std::atoi(item.c_str()));
+    }
+    return values;
+}
+
+// Peak resident set size of the whole process so far, 0 where unsupported
+uint64_t PeakRssBytes() {
+#if defined(__unix__) || defined(__APPLE__)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#if defined(__APPLE__)
+    return static_cast<uint64_t>(usage.ru_maxrss); // bytes on macOS
+#else
+    return static_cast<uint64_t>(usage.ru_maxrss) * 1024; // kilobytes on Linux
+#endif
+#else
+    return 0;
+#endif
+}
+
+BenchResult RunOnce(WorldGenConfig config, int size, unsigned threads, TileStorage storage) {
+    BenchResult result;
+    result.size = size;
+    result.threads = threads;
+    config.width = size;
+    config.height = size;
+
+    auto start = std::chrono::steady_clock::now();
+    WorldTiles world = GenerateWorld(config, threads, storage, nullptr, &result.stages);
+    result.totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    result.contentHash = WorldContentHash(world);
+    result.worldBytes = world.MemoryBytes();
+    return result;
+}
+
+struct RaycastCheck {
+    int size = 0;
+    int rays = 0;
+    int hits = 0;
+    int mismatches = 0;
+    double nsPerRay = 0.0;
+    double referenceNsPerRay = 0.0;
+};
+
+// Raycast reference: every tile in the segment's bounding box is tested as a flat-topped
+// prism of its elevation, and the earliest hit wins
+float ReferenceRaycast(const WorldTiles& world, float x0, float y0, float z0, float x1, float y1, float z1) {
+    const float dx = x1 - x0;
+    const float dy = y1 - y0;
+    const float dz = z1 - z0;
+    const int minX = std::max(0, static_cast<int>(std::floor(std::min(x0, x1))));
+    const int minY = std::max(0, static_cast<int>(std::floor(std::min(y0, y1))));
+    const int maxX = std::min(world.Width() - 1, static_cast<int>(std::floor(std::max(x0, x1))));
+    const int maxY = std::min(world.Height() - 1, static_cast<int>(std::floor(std::max(y0, y1))));
+    float first = -1.0f;
+    for (int y = minY; y <= maxY; ++y) {
+        for (int x = minX; x <= maxX; ++x) {
+            float tBegin = 0.0f;
+            float tEnd = 1.0f;
+            auto clip = [&](float origin, float direction, float low, float high) {
+                if (direction == 0.0f) {
+                    if (origin < low || origin > high) tEnd = -1.0f;
+                    return;
+                }
+                float tLow = (low - origin) / direction;
+                float tHigh = (high - origin) / direction;
+                if (tLow > tHigh) std::swap(tLow, tHigh);
+                tBegin = std::max(tBegin, tLow);
+                tEnd = std::min(tEnd, tHigh);
+            };
+            clip(x0, dx, static_cast<float>(x), static_cast<float>(x + 1));
+            clip(y0, dy, static_cast<float>(y), static_cast<float>(y + 1));
+            if (tBegin > tEnd) continue;
+
+            const float elevation = world.elevation(x, y);
+            const float zBegin = z0 + dz * tBegin;
+            const float zEnd = z0 + dz * tEnd;
+            if (std::min(zBegin, zEnd) >= elevation) continue;
+            const float hit = zBegin < elevation ? tBegin : std::clamp((elevation - z0) / dz, tBegin, tEnd);
+            if (first < 0.0f || hit < first) first = hit;
+        }
+    }
+    return first;
+}
+
+// Segments up to 32 tiles long, keeping the reference's bounding boxes small, with heights
+// spanning the world's elevations so both hits and misses come up
+RaycastCheck CheckRaycasts(const WorldGenConfig& config, int size, int rays) {
+    RaycastCheck check;
+    check.size = size;
+    check.rays = rays;
+    WorldGenConfig checkConfig = config;
+    checkConfig.width = size;
+    checkConfig.height = size;
+    const WorldTiles world = GenerateWorld(checkConfig);
+    const ElevationPyramid pyramid(world);
+
+    int minElevation = world.elevation(0, 0);
+    int maxElevation = minElevation;
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            minElevation = std::min<int>(minElevation, world.elevation(x, y));
+            maxElevation = std::max<int>(maxElevation, world.elevation(x, y));
+        }
+    }
+
+    std::mt19937 rng(config.seed);
+    std::uniform_real_distribution<float> position(0.0f, static_cast<float>(size));
+    std::uniform_real_distribution<float> offset(-32.0f, 32.0f);
+    std::uniform_real_distribution<float> height(minElevation - 4.0f, maxElevation + 4.0f);
+    std::vector<float> segments(static_cast<size_t>(rays) * 6);
+    for (int i = 0; i < rays; ++i) {
+        float* s = &segments[static_cast<size_t>(i) * 6];
+        s[0] = position(rng);
+        s[1] = position(rng);
+        s[2] = height(rng);
+        s[3] = s[0] + offset(rng);
+        s[4] = s[1] + offset(rng);
+        s[5] = height(rng);
+    }
+
+    std::vector<float> fast(rays), reference(rays);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rays; ++i) {
+        const float* s = &segments[static_cast<size_t>(i) * 6];
+        fast[i] = pyramid.Raycast(s[0], s[1], s[2], s[3], s[4], s[5]);
+    }
+    auto middle = std::chrono::steady_clock::now();
+    for (int i = 0; i < rays; ++i) {
+        const float* s = &segments[static_cast<size_t>(i) * 6];
+        reference[i] = ReferenceRaycast(world, s[0], s[1], s[2], s[3], s[4], s[5]);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < rays; ++i) {
+        if (reference[i] >= 0.0f) check.hits++;
+        if ((fast[i] < 0.0f) != (reference[i] < 0.0f) || std::abs(fast[i] - reference[i]) > 1e-5f) {
+            check.mismatches++;
+        }
+    }
+    if (rays > 0) {
+        check.nsPerRay = std::chrono::duration<double, std::nano>(middle - start).count() / rays;
+        check.referenceNsPerRay = std::chrono::duration<double, std::nano>(end - middle).count() / rays;
+    }
+    return check;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::vector<int> sizes = {128, 256, 512};
+    std::vector<int> threadCounts = {1, 0};
+    int repeat = 5;
+    TileStorage storage = TileStorage::Full;
+    WorldGenConfig config;
+    int rays = 20000;
+
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--sizes") == 0 && hasValue) {
+            sizes = ParseList(argv[++i]);
+        } else if (std::strcmp(argv[i], "--threads") == 0 && hasValue) {
+            threadCounts = ParseList(argv[++i]);
+        } else if (std::strcmp(argv[i], "--repeat") == 0 && hasValue) {
+            repeat = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--compact") == 0) {
+            storage = TileStorage::Compact;
+        } else if (std::strcmp(argv[i], "--seed") == 0 && hasValue) {
+            config.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--rays") == 0 && hasValue) {
+            rays = std::max(0, std::atoi(argv[++i]));
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--sizes 128,256,512] [--threads 1,2,4] [--repeat 5] [--compact] [--seed 1]"
+                      << " [--rays 20000]" << std::endl;
+            return 1;
+        }
+    }
+
+    RaycastCheck raycast;
+    if (rays > 0 && !sizes.empty() && sizes[0] > 0) {
+        raycast = CheckRaycasts(config, sizes[0], rays);
+        if (raycast.mismatches > 0) {
+            std::cerr << "Raycast check failed: " << raycast.mismatches << " of " << rays
+                      << " rays disagree with the reference" << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << "{\n";
+    std::cout << "  \"noise_kernel\": \"" << NoiseKernelName(ActiveNoiseKernel()) << "\",\n";
+    std::cout << "  \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n";
+    std::cout << "  \"repeat\": " << repeat << ",\n";
+    std::cout << "  \"seed\": " << config.seed << ",\n";
+    std::cout << "  \"storage\": \"" << (storage == TileStorage::Compact ? "compact" : "full") << "\",\n";
+    if (raycast.rays > 0) {
+        std::cout << "  \"raycast_check\": {\"size\": " << raycast.size << ", \"rays\": " << raycast.rays
+                  << ", \"hits\": " << raycast.hits << ", \"mismatches\": " << raycast.mismatches
+                  << ", \"ns_per_ray\": " << raycast.nsPerRay
+                  << ", \"reference_ns_per_ray\": " << raycast.referenceNsPerRay << "},\n";
+    }
+    std::cout << "  \"runs\": [";
+
+    bool first = true;
+    for (int size : sizes) {
+        for (int threads : threadCounts) {
+            if (size <= 0 || threads < 0) continue;
+            BenchResult best;
+            for (int r = 0; r < repeat; ++r) {
+                BenchResult run = RunOnce(config, size, static_cast<unsigned>(threads), storage);
+                if (r == 0 || run.totalMs < best.totalMs) best = run;
+            }
+
+            const double tiles = double(size) * size;
+            std::cout << (first ? "\n" : ",\n");
+            std::cout << "    {\"width\": " << size << ", \"height\": " << size
+                      << ", \"threads\": " << best.threads
+                      << ", \"total_ms\": " << best.totalMs
+                      << ", \"stages_ms\": {\"noise\": " << best.stages.noiseMs
+                      << ", \"river_carve\": " << best.stages.carveMs
+                      << ", \"smoothing\": " << best.stages.smoothMs
+                      << ", \"biome_color\": " << best.stages.classifyMs << "}"
+                      << ", \"tiles_per_sec\": " << (best.totalMs > 0.0 ? tiles / (best.totalMs / 1000.0) : 0.0)
+                      << ", \"world_bytes\": " << best.worldBytes
+                      << ", \"peak_rss_bytes\": " << PeakRssBytes()
+                      << ", \"content_hash\": \"" << std::hex << best.contentHash << std::dec << "\"}";
+            first = false;
+        }
+    }
+    std::cout << "\n  ]\n}" << std::endl;
+    return 0;
+}
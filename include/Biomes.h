@@ -0,0 +1,135 @@
+#ifndef BIOMES_H
+#define BIOMES_H
+
+#include <algorithm> // For std::clamp
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "DataTypes.h"     // For BiomeType, BiomeProperties
+#include "GameConstants.h" // For the biome levels
+
+const size_t BIOME_COUNT = 8;
+
+// Properties of every biome, indexed by BiomeType
+constexpr std::array<BiomeProperties, BIOME_COUNT> BIOME_PROPERTIES = {{
+    {{0, 64, 220, 255},    0.3f, 0.1f, false}, // DEEP_WATER
+    {{0, 128, 255, 255},   0.5f, 0.2f, false}, // SHALLOW_WATER
+    {{240, 220, 180, 255}, 0.6f, 0.2f, true},  // BEACH
+    {{100, 210, 100, 255}, 1.0f, 0.3f, true},  // PLAINS
+    {{21, 120, 35, 255},   1.1f, 0.4f, true},  // FOREST
+    {{90, 160, 90, 255},   1.2f, 0.6f, true},  // HILLS
+    {{150, 140, 130, 255}, 1.5f, 0.8f, false}, // MOUNTAINS
+    {{255, 255, 255, 255}, 1.6f, 0.9f, false}, // SNOW_CAPS
+}};
+
+constexpr const BiomeProperties& GetBiomeProperties(BiomeType biome) {
+    return BIOME_PROPERTIES[static_cast<size_t>(biome)];
+}
+
+// Biome rules as a plain decision ladder. Only used to build the lookup table below.
+constexpr BiomeType ClassifyBiomeReference(float elevation, float moisture) {
+    // Water biomes based on depth
+    if (elevation < WATER_LEVEL - 5.0f) return BiomeType::DEEP_WATER;
+    if (elevation < WATER_LEVEL) return BiomeType::SHALLOW_WATER;
+
+    // Beach and coastal areas
+    if (elevation < BEACH_LEVEL) return BiomeType::BEACH;
+
+    // Lowlands - plains and forests based on moisture
+    if (elevation < PLAINS_LEVEL) {
+        if (moisture < 0.3f) return BiomeType::PLAINS; // Dry plains
+        if (moisture < 0.6f) return BiomeType::PLAINS; // Standard plains
+        return BiomeType::FOREST; // Forests in moist areas
+    }
+
+    // Hills and highlands
+    if (elevation < HILLS_LEVEL) {
+        if (moisture < 0.4f) return BiomeType::HILLS; // Dry hills
+        return BiomeType::FOREST; // Forested hills
+    }
+
+    // Mountains and peaks
+    if (elevation < MOUNTAIN_LEVEL) {
+        return BiomeType::MOUNTAINS; // Rocky mountains
+    }
+
+    // Snow-capped peaks at highest elevations
+    return BiomeType::SNOW_CAPS;
+}
+
+// Elevation/moisture -> biome lookup table
+// Every elevation threshold of the ladder is a whole number, so the biome only changes at
+// integer elevations and one row per integer in [BIOME_LUT_MIN_ELEVATION,
+// BIOME_LUT_MAX_ELEVATION] reproduces it exactly; anything outside clamps to the end rows.
+// Moisture is reduced to the number of ladder thresholds it reaches.
+constexpr int BIOME_LUT_MIN_ELEVATION = static_cast<int>(WATER_LEVEL - 5.0f) - 1;
+constexpr int BIOME_LUT_MAX_ELEVATION = static_cast<int>(MOUNTAIN_LEVEL);
+constexpr int BIOME_LUT_ROWS = BIOME_LUT_MAX_ELEVATION - BIOME_LUT_MIN_ELEVATION + 1;
+constexpr std::array<float, 3> BIOME_MOISTURE_THRESHOLDS = {0.3f, 0.4f, 0.6f};
+constexpr int BIOME_MOISTURE_CLASSES = static_cast<int>(BIOME_MOISTURE_THRESHOLDS.size()) + 1;
+
+static_assert(WATER_LEVEL - 5.0f == static_cast<int>(WATER_LEVEL - 5.0f) &&
+              WATER_LEVEL == static_cast<int>(WATER_LEVEL) && BEACH_LEVEL == static_cast<int>(BEACH_LEVEL) &&
+              PLAINS_LEVEL == static_cast<int>(PLAINS_LEVEL) && HILLS_LEVEL == static_cast<int>(HILLS_LEVEL) &&
+              MOUNTAIN_LEVEL == static_cast<int>(MOUNTAIN_LEVEL),
+              "The biome lookup table needs whole-number elevation thresholds");
+static_assert(BIOME_LUT_MIN_ELEVATION >= 0, "LookupBiome truncates, which only floors non-negative values");
+
+constexpr std::array<BiomeType, BIOME_LUT_ROWS * BIOME_MOISTURE_CLASSES> BuildBiomeLookup() {
+    std::array<BiomeType, BIOME_LUT_ROWS * BIOME_MOISTURE_CLASSES> table{};
+    for (int row = 0; row < BIOME_LUT_ROWS; ++row) {
+        for (int moistureClass = 0; moistureClass < BIOME_MOISTURE_CLASSES; ++moistureClass) {
+            // Each class is represented by the lowest moisture that falls into it
+            float moisture = moistureClass == 0 ? 0.0f : BIOME_MOISTURE_THRESHOLDS[moistureClass - 1];
+            table[row * BIOME_MOISTURE_CLASSES + moistureClass] =
+                ClassifyBiomeReference(static_cast<float>(BIOME_LUT_MIN_ELEVATION + row), moisture);
+        }
+    }
+    return table;
+}
+
+constexpr std::array<BiomeType, BIOME_LUT_ROWS * BIOME_MOISTURE_CLASSES> BIOME_LOOKUP = BuildBiomeLookup();
+
+// Same result as ClassifyBiomeReference without branches: a clamp, a truncation, three
+// compares and one table load
+inline BiomeType LookupBiome(float elevation, float moisture) {
+    const float clamped = std::clamp(elevation, float(BIOME_LUT_MIN_ELEVATION), float(BIOME_LUT_MAX_ELEVATION));
+    const int row = static_cast<int>(clamped) - BIOME_LUT_MIN_ELEVATION; // clamped is positive, so this floors
+    const int moistureClass = int(moisture >= BIOME_MOISTURE_THRESHOLDS[0]) +
+                              int(moisture >= BIOME_MOISTURE_THRESHOLDS[1]) +
+                              int(moisture >= BIOME_MOISTURE_THRESHOLDS[2]);
+    return BIOME_LOOKUP[row * BIOME_MOISTURE_CLASSES + moistureClass];
+}
+
+// splitmix64 finalizer over (seed, x, y): a well-mixed 64-bit value per tile without any
+// generator state, so tile colors are reproducible and cost a few cycles each
+constexpr uint64_t TileHash(uint32_t seed, int x, int y) {
+    uint64_t z = ((uint64_t(uint32_t(x)) << 32) | uint32_t(y)) ^ (uint64_t(seed) * 0xD6E8FEB86659FD93ull);
+    z += 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// Color of a tile of biome at world position (worldX, worldY) of the world generated from
+// seed, which is worldWidth x worldHeight tiles, or 0 x 0 when unbounded (streamed).
+// Depends on nothing else, so compact worlds decode it instead of storing it.
+constexpr SDL_Color TileColor(BiomeType biome, int worldX, int worldY, uint32_t seed, int worldWidth, int worldHeight) {
+    // Debug coloring pattern from main.cpp; only a fixed world has a border and center lines
+    if ((worldX + worldY) % 10 == 0) return {255, 0, 0, 255};
+    if (worldWidth > 0 && worldHeight > 0) {
+        if (worldX == 0 || worldY == 0 || worldX == worldWidth-1 || worldY == worldHeight-1) return {255, 255, 0, 255};
+        if (worldX == worldWidth/2 || worldY == worldHeight/2) return {0, 0, 255, 255};
+    }
+
+    // Stateless per-tile jitter of -5..5 on each channel, one 16-bit slice each
+    const SDL_Color base = GetBiomeProperties(biome).baseColor;
+    const uint64_t hash = TileHash(seed, worldX, worldY);
+    auto jitter = [hash](int channel, int shift) {
+        const int variation = static_cast<int>(((hash >> shift) & 0xFFFF) * 11 >> 16) - 5;
+        return static_cast<Uint8>(std::clamp(channel + variation, 0, 255));
+    };
+    return {jitter(base.r, 0), jitter(base.g, 16), jitter(base.b, 32), 255};
+}
+
+#endif // BIOMES_H
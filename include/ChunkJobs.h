@@ -0,0 +1,75 @@
+#ifndef CHUNKJOBS_H
+#define CHUNKJOBS_H
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "Noise.h"
+#include "SpscQueue.h"
+
+struct Chunk;
+struct WorldGenConfig;
+
+// Finished (or dropped) chunk generation request
+struct ChunkJobResult {
+    int chunkX = 0;
+    int chunkY = 0;
+    std::unique_ptr<Chunk> chunk; // nullptr when the request went stale before it ran
+};
+
+// Background chunk generation.
+// The main thread posts chunk requests and picks up finished chunks; workers run the
+// GenerateRegion pipeline. Workers always take the pending request closest to the latest
+// center, and drop requests that have moved out of range. Each worker publishes through
+// its own single-producer/single-consumer queue, so collecting results never blocks the
+// main thread, and posting requests only ever try-locks. Each worker keeps a scratch arena
+// for intermediate buffers and generates into recycled chunks when it has them.
+class ChunkJobSystem {
+public:
+    // config and noise must outlive the system
+    ChunkJobSystem(const WorldGenConfig& config, const NoiseGenerator& noise, unsigned workerCount);
+    ~ChunkJobSystem();
+
+    ChunkJobSystem(const ChunkJobSystem&) = delete;
+    ChunkJobSystem& operator=(const ChunkJobSystem&) = delete;
+
+    // Main thread only. Requests further than keepRadius chunks from the center are dropped.
+    void SetCenter(int chunkX, int chunkY, int keepRadius);
+    // Main thread only. Returns false without blocking if the request list is busy;
+    // the caller keeps the requests and tries again next frame.
+    bool TryRequest(const std::vector<std::pair<int, int>>& chunkCoords);
+    // Main thread only. Hands chunks back for workers to generate into instead of allocating.
+    // Takes chunks until CHUNK_SPARE_LIMIT are waiting and leaves the rest in chunks; returns
+    // false without blocking (taking nothing) if the request list is busy.
+    bool TryRecycle(std::vector<std::unique_ptr<Chunk>>& chunks);
+    // Main thread only. Returns false once no finished result is waiting.
+    bool TryPopResult(ChunkJobResult& out);
+
+    unsigned WorkerCount() const { return static_cast<unsigned>(workers.size()); }
+
+private:
+    void WorkerLoop(unsigned workerIndex);
+    bool TakeClosestRequest(int& chunkX, int& chunkY, bool& stale);
+
+    const WorldGenConfig& config;
+    const NoiseGenerator& noise;
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<SpscQueue<ChunkJobResult>>> results; // One per worker
+    unsigned nextResultQueue = 0;
+
+    std::mutex requestMutex;
+    std::condition_variable requestReady;
+    std::vector<std::pair<int, int>> pending; // Guarded by requestMutex
+    std::vector<std::unique_ptr<Chunk>> spareChunks; // Guarded by requestMutex
+    bool stopping = false;
+
+    std::atomic<int> centerX{0};
+    std::atomic<int> centerY{0};
+    std::atomic<int> keepRadius{0};
+};
+
+#endif // CHUNKJOBS_H
@@ -0,0 +1,102 @@
+#ifndef CHUNKMANAGER_H
+#define CHUNKMANAGER_H
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "ChunkJobs.h"
+#include "Noise.h"
+#include "ScratchArena.h"
+#include "TerrainSource.h"
+#include "World.h" // For WorldGenConfig
+#include "WorldTiles.h"
+
+// CHUNK_SIZE x CHUNK_SIZE block of an unbounded world
+struct Chunk {
+    int chunkX = 0;
+    int chunkY = 0;
+    WorldTiles tiles;
+};
+
+// Fills chunk.tiles with the chunk at (chunk.chunkX, chunk.chunkY). Tiles already of chunk
+// size are overwritten in place, so a recycled chunk costs no allocation; scratch is reset
+// before returning.
+void GenerateChunk(const WorldGenConfig& config, const NoiseGenerator& noise, ScratchArena& scratch, Chunk& chunk);
+
+// Chunk coordinate containing a world tile coordinate (rounds toward negative infinity)
+inline int TileToChunk(int tile) {
+    return tile >= 0 ? tile / CHUNK_SIZE : -((-tile + CHUNK_SIZE - 1) / CHUNK_SIZE);
+}
+
+// Streams an unbounded world in CHUNK_SIZE chunks around a moving center.
+// Update() generates missing chunks within loadRadius chunks of the center and then evicts
+// least recently used chunks until resident tile memory fits the budget. Chunks inside the
+// load radius are never evicted, so a budget smaller than the radius needs is exceeded
+// rather than thrashing.
+// With worker threads, missing chunks are generated in the background (closest first) and
+// show up in a later Update(); until then BlockAt reports them as not resident. Without
+// workers, Update() generates them inline before returning.
+// Evicted chunks are not freed but kept (up to CHUNK_SPARE_LIMIT, outside the budget) and
+// generated into again, so streaming runs without heap allocations once it has warmed up.
+class ChunkManager : public TerrainSource {
+public:
+    // Chunks are cut from the unbounded world of config; its size is ignored
+    ChunkManager(size_t memoryBudgetBytes = CHUNK_MEMORY_BUDGET, int loadRadius = CHUNK_LOAD_RADIUS,
+                 unsigned workerThreads = 0, const WorldGenConfig& config = WorldGenConfig());
+
+    // centerX/centerY in world tile coordinates, typically the player position.
+    // Never waits on workers: it only collects chunks that are already finished.
+    void Update(float centerX, float centerY);
+
+    const Chunk* FindChunk(int chunkX, int chunkY) const;
+    size_t ChunkCount() const { return chunks.size(); }
+    size_t MemoryUsed() const { return memoryUsed; }
+    size_t PendingCount() const { return inFlight.size(); } // Requested but not yet received
+    // Changes whenever a chunk is added or evicted, so callers can tell the terrain changed
+    uint64_t Revision() const { return revision; }
+
+    TerrainBlock BlockAt(int x, int y) const override;
+    TileBounds Bounds() const override { return TileBounds{}; }
+    ElevationRange ElevationBounds() const override { return elevationRange; }
+
+private:
+    struct Entry {
+        std::unique_ptr<Chunk> chunk;
+        std::list<uint64_t>::iterator lruPosition;
+    };
+
+    static uint64_t Key(int chunkX, int chunkY) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(chunkX)) << 32) | static_cast<uint32_t>(chunkY);
+    }
+
+    void Touch(Entry& entry);
+    void Insert(std::unique_ptr<Chunk> chunk);
+    void EvictOverBudget(int centerChunkX, int centerChunkY);
+    std::unique_ptr<Chunk> TakeSpareChunk();
+
+    WorldGenConfig config;
+    NoiseGenerator noise;
+    size_t memoryBudget;
+    int loadRadius;
+    size_t memoryUsed = 0;
+    uint64_t revision = 0;
+    bool hasElevation = false;
+    ElevationRange elevationRange; // Grows to cover every chunk generated so far
+
+    std::unordered_map<uint64_t, Entry> chunks;
+    std::list<uint64_t> lru; // Front is the most recently used chunk
+    std::vector<std::unique_ptr<Chunk>> spareChunks; // Evicted, waiting to be generated into
+    ScratchArena scratch;                            // Synchronous generation only
+
+    // Background generation state, unused when running synchronously.
+    // Declared after config and noise so the workers stop before what they read goes away.
+    std::unique_ptr<ChunkJobSystem> jobs;
+    std::unordered_set<uint64_t> inFlight;           // Requested, result not collected yet
+    std::vector<std::pair<int, int>> unsentRequests; // Kept when the request list was busy
+};
+
+#endif // CHUNKMANAGER_H
@@ -0,0 +1,75 @@
+#ifndef CHUNKTEXTURECACHE_H
+#define CHUNKTEXTURECACHE_H
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <unordered_map>
+#include "DataTypes.h"     // For Camera
+#include "GameConstants.h" // For RENDER_CHUNK_SIZE, RENDER_CHUNK_CACHE_TEXTURES
+#include "Renderer.h"      // For TileBatch
+#include "TerrainSource.h"
+#include "Visibility.h"
+
+// What one Draw call did, for the debug overlay
+struct ChunkTextureStats {
+    int texturesDrawn = 0;  // SDL_RenderCopy calls
+    int texturesBaked = 0;  // Blocks rendered into their texture this frame
+    int tilesCovered = 0;   // Tiles inside the drawn textures
+    int fallbackTiles = 0;  // Tiles visited by the per-tile path instead
+};
+
+// Render-to-texture cache for static terrain.
+// The terrain is cut into RENDER_CHUNK_SIZE square blocks. Each resident block is drawn once
+// into its own target texture with the same tile geometry TileBatch uses, and later frames
+// copy the texture to the screen offset and scaled by the camera. Because the projection
+// only shifts and scales with the camera, a baked block stays valid until its tiles change.
+// Blocks whose tiles are not resident yet go through the per-tile path with placeholders.
+class ChunkTextureCache {
+public:
+    explicit ChunkTextureCache(SDL_Renderer* renderer, size_t maxTextures = RENDER_CHUNK_CACHE_TEXTURES);
+    ~ChunkTextureCache();
+
+    ChunkTextureCache(const ChunkTextureCache&) = delete;
+    ChunkTextureCache& operator=(const ChunkTextureCache&) = delete;
+
+    // False when the renderer cannot draw into textures; Draw must not be used then
+    bool Supported() const { return supported; }
+
+    // Copies every visible block to the screen in back-to-front order, baking missing or
+    // dirty blocks first. Tiles that cannot be baked are added to fallback, which the
+    // caller draws afterwards.
+    ChunkTextureStats Draw(const TerrainSource& terrain, const VisibleTileRange& visible,
+                           const Camera& camera, TileBatch& fallback);
+
+    // Marks every block touching the tile rectangle [minX, maxX] x [minY, maxY] for rebaking
+    void Invalidate(int minX, int minY, int maxX, int maxY);
+    // Drops every texture, e.g. after SDL_RENDER_TARGETS_RESET lost their contents
+    void InvalidateAll();
+
+    size_t TextureCount() const { return entries.size(); }
+
+private:
+    struct Entry {
+        SDL_Texture* texture = nullptr;
+        int width = 0;
+        int height = 0;
+        int originX = 0;                       // Texture position of the block's (0, 0) tile center at elevation 0
+        int originY = 0;
+        const WorldTiles* source = nullptr;    // Storage the block was baked from
+        bool dirty = true;
+        uint64_t lastDrawn = 0;                // Frame number, for eviction
+    };
+
+    bool Bake(Entry& entry, const TerrainBlock& block, int blockX, int blockY);
+    void EvictUnused();
+
+    SDL_Renderer* renderer;
+    size_t maxTextures;
+    bool supported;
+    uint64_t frame = 0;
+    std::unordered_map<uint64_t, Entry> entries; // Keyed by packed block coordinates
+    TileBatch bakeBatch;                         // Reused between bakes
+    VisibleTileRange fallbackRange;              // Visible part of one unbaked block
+};
+
+#endif // CHUNKTEXTURECACHE_H
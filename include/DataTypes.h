@@ -6,7 +6,8 @@
 
 // Add these new structures before the existing ones
 // Update BiomeType enum
-enum class BiomeType {
+// Stored once per tile in WorldTiles, so it is kept to a single byte
+enum class BiomeType : Uint8 {
     DEEP_WATER,
     SHALLOW_WATER,
     BEACH,
@@ -51,14 +52,24 @@ struct Player {
 };
 
 struct Camera {
+    // Screen-space position of the viewport's top-left corner. WorldToScreen subtracts it
+    // from the projected point, so it is the whole per-frame camera offset.
     float x = 0;
     float y = 0;
+    // Screen pixels per unzoomed pixel; the offset above is in zoomed pixels
+    float zoom = 1.0f;
 
-    // Forward declaration of Player for the update method
-    // The actual definition of Player is above, but this avoids a circular dependency
-    // if Player methods were to use Camera, and Camera methods use Player.
-    // However, in this simple case, it's fine as Player is fully defined before Camera.
-    void update(const Player& player); // Implementation will be in Camera.cpp or main.cpp initially
+    // Eases toward centering the player by CAMERA_FOLLOW_SPEED per reference tick;
+    // deltaTime in seconds
+    void update(const Player& player, float deltaTime);
+    // Centers the player immediately
+    void snap(const Player& player);
+    // True once update() has brought the player within tolerance pixels of centered
+    bool settled(const Player& player, float tolerance) const;
+    // World position shown at the screen center, for tiles at the given elevation
+    void viewCenter(float elevation, float& worldX, float& worldY) const;
+    // Changes the zoom while keeping the world point at the screen center where it is
+    void setZoom(float zoom, float elevation);
 };
 
 #endif // DATATYPES_H
@@ -0,0 +1,52 @@
+#ifndef ENTITIES_H
+#define ENTITIES_H
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "GameConstants.h"
+#include "TerrainSource.h"
+#include "WorldGrid.h" // For AlignedAllocator
+
+class ThreadPool;
+
+// NPCs and creatures, stored one array per field so the physics passes stream through
+// contiguous floats. Entities follow the same terrain-follow, gravity and landing rules as
+// the player, but nothing here reads input: whoever drives an entity sets its velocity or
+// calls Jump, and UpdateEntities integrates everything at once.
+// Moving entities bounce: a velocity component is reversed when the world bounds clamp it
+// or (with ENFORCE_WALKABILITY) when the step was blocked.
+class EntityStore {
+public:
+    template <typename T>
+    using Column = std::vector<T, AlignedAllocator<T>>;
+
+    // Returns the new entity's index; the elevation starts at the given value and eases
+    // onto the terrain like the player's
+    size_t Add(float x, float y, float elevation, float velocityX, float velocityY, SDL_Color color);
+    void Clear();
+    size_t Count() const { return x.size(); }
+
+    // Starts a jump unless the entity is already in the air
+    void Jump(size_t index);
+    // True when no entity will move on the next update
+    bool AtRest() const;
+
+    // Position after the last update and before it, for interpolated drawing
+    Column<float> x, y, elevation;
+    Column<float> previousX, previousY, previousElevation;
+    // velocityX/Y in tiles per second; velocityZ in elevation per second
+    Column<float> velocityX, velocityY, velocityZ;
+    Column<uint8_t> isJumping; // 1 while in the air
+    std::vector<SDL_Color> color;
+};
+
+// Advances every entity by deltaTime seconds. With a pool, entities are split into one
+// band per thread; each entity only touches its own slots, so results are identical for
+// any thread count. Inside a band entities are processed in fixed-size batches: motion,
+// bounds and gravity are branch-free loops the compiler vectorizes, and the terrain is
+// sampled for the whole batch with HeightsAt.
+void UpdateEntities(EntityStore& entities, float deltaTime, const TerrainSource& world, ThreadPool* pool = nullptr);
+
+#endif // ENTITIES_H
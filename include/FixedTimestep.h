@@ -0,0 +1,40 @@
+#ifndef FIXEDTIMESTEP_H
+#define FIXEDTIMESTEP_H
+
+#include <SDL2/SDL.h>
+
+// Accumulator for a fixed-timestep simulation driven by SDL_GetPerformanceCounter.
+// Each frame, Advance() turns the real time since the previous frame into a whole number of
+// simulation steps; the remainder carries over, and Alpha() says how far the render frame
+// lies between the last two steps.
+class FixedTimestep {
+public:
+    FixedTimestep(double stepSeconds, int maxStepsPerFrame);
+
+    // Measures the time since the previous call and returns the steps to simulate now.
+    // More than maxStepsPerFrame steps of backlog are dropped, so a long stall (a breakpoint,
+    // a window drag) slows the game down instead of freezing it while it catches up.
+    int Advance();
+    // Same as Advance with a given frame time instead of a measured one. Replays feed the
+    // recorded frame times here, so they simulate the same steps whatever the frame rate.
+    int AdvanceBy(double seconds);
+    // Restarts the clock from now, so time spent idle (waiting for input with nothing to
+    // simulate) is not simulated in one burst afterwards
+    void Resync();
+
+    double StepSeconds() const { return step; }
+    // Fraction of a step left in the accumulator, in [0, 1)
+    float Alpha() const { return static_cast<float>(accumulator / step); }
+    // Real time of the last frame in seconds
+    double FrameSeconds() const { return frameSeconds; }
+
+private:
+    double step;
+    int maxSteps;
+    double secondsPerTick;
+    Uint64 lastCounter;
+    double accumulator = 0.0;
+    double frameSeconds = 0.0;
+};
+
+#endif // FIXEDTIMESTEP_H
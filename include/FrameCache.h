@@ -0,0 +1,65 @@
+#ifndef FRAMECACHE_H
+#define FRAMECACHE_H
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+
+// Everything a frame's picture depends on. Two frames with matching states look the same,
+// so the second one does not need to be drawn at all.
+struct FrameState {
+    float cameraX = 0.0f;
+    float cameraY = 0.0f;
+    float zoom = 1.0f;
+    float playerX = 0.0f;         // Interpolated player the frame draws
+    float playerY = 0.0f;
+    float playerElevation = 0.0f;
+    int lodLevel = 0;
+    uint64_t terrainRevision = 0; // Changes whenever visible tiles may have changed
+    bool debugMode = false;
+    bool chunkTextures = false;
+};
+
+// How a frame differs from the last one drawn
+enum class FrameChange {
+    None,       // Same picture; skip the frame and leave the last one on screen
+    PlayerOnly, // Terrain unchanged; redraw the player (and overlay) over the cached terrain
+    Full        // Terrain must be drawn again
+};
+
+// Camera and player movement smaller than FRAME_SKIP_TOLERANCE_PX on screen counts as no
+// movement, so the camera's endless easing toward the player settles into a skipped frame.
+// Always compare against the state of the last frame actually drawn, so creeping movement
+// adds up and is eventually drawn.
+FrameChange CompareFrames(const FrameState& drawn, const FrameState& next);
+
+// Screen-sized render target holding the terrain of the last fully drawn frame. Frames
+// where only the player moved copy it to the screen instead of resubmitting every tile.
+// The screen itself cannot be patched in place: its contents are undefined after
+// SDL_RenderPresent, so every presented frame starts from this copy.
+class TerrainFrameCache {
+public:
+    explicit TerrainFrameCache(SDL_Renderer* renderer);
+    ~TerrainFrameCache();
+
+    TerrainFrameCache(const TerrainFrameCache&) = delete;
+    TerrainFrameCache& operator=(const TerrainFrameCache&) = delete;
+
+    // Redirects drawing into the cache, cleared to the given color. Returns false (drawing
+    // stays on the screen) when render targets are unavailable.
+    bool BeginCapture(SDL_Color clearColor);
+    // Switches back to the screen and copies the captured terrain onto it
+    void EndCapture();
+    // Copies the last captured terrain to the screen; false when there is none
+    bool Draw();
+    // Forgets the captured terrain, e.g. after SDL_RENDER_TARGETS_RESET lost it
+    void Invalidate() { valid = false; }
+
+private:
+    SDL_Renderer* renderer;
+    SDL_Texture* texture = nullptr;
+    bool supported;
+    bool capturing = false;
+    bool valid = false;
+};
+
+#endif // FRAMECACHE_H
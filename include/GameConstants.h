@@ -1,11 +1,20 @@
 #ifndef GAMECONSTANTS_H
 #define GAMECONSTANTS_H
 
+#include <cstddef> // For size_t
+
 // Update these constants for better camera control
 const float CAMERA_FOLLOW_SPEED = 0.1f; // Adjust this value between 0.05f and 0.2f for smooth following
 const float PLAYER_SPEED = 5.0f; // Increased for better responsiveness
-const float JUMP_FORCE = 10.0f; // Increased for higher jumps
-const float GRAVITY = 0.3f;
+const float JUMP_FORCE = 10.0f; // Increased for higher jumps; elevation per reference tick
+const float GRAVITY = 0.3f;     // Velocity lost per reference tick
+const float PHYSICS_REFERENCE_RATE = 60.0f; // Ticks per second JUMP_FORCE and GRAVITY were tuned at
+// Block movement into non-walkable tiles; off because spawn points are not chosen on land yet
+const bool ENFORCE_WALKABILITY = false;
+
+// Fixed-timestep simulation constants
+const double SIMULATION_TIMESTEP = 1.0 / 60.0; // Seconds per simulation step
+const int MAX_SIMULATION_STEPS = 8;            // Steps per frame before falling behind instead of stalling
 const int PLAYER_SIZE = 30;
 const float INITIAL_ELEVATION = 0.0f;
 const int SCREEN_WIDTH = 1280;
@@ -23,22 +32,60 @@ const int HEAD_SIZE = 15;
 const int LIMB_WIDTH = 6;
 const int LIMB_LENGTH = 15;
 
+// Entity (NPC and creature) constants
+const int ENTITY_WIDTH = 12;
+const int ENTITY_HEIGHT = 24;
+const int ENTITY_HEAD_SIZE = 9;
+const float ENTITY_WANDER_SPEED = 2.0f; // Tiles per second of spawned wanderers
+
 // Add these new constants after the existing ones
 const int NUM_OCTAVES = 4;
 const float PERSISTENCE = 0.5f;
 const float BASE_FREQUENCY = 0.01f;
 
 // Add these new biome and terrain constants
-const float WATER_LEVEL = 20.0f;
-const float BEACH_LEVEL = 23.0f;
-const float PLAINS_LEVEL = 35.0f;
-const float HILLS_LEVEL = 50.0f;
-const float MOUNTAIN_LEVEL = 70.0f;
+// constexpr so the biome lookup table in Biomes.h can be built from them at compile time
+constexpr float WATER_LEVEL = 20.0f;
+constexpr float BEACH_LEVEL = 23.0f;
+constexpr float PLAINS_LEVEL = 35.0f;
+constexpr float HILLS_LEVEL = 50.0f;
+constexpr float MOUNTAIN_LEVEL = 70.0f;
 
 // Add new noise layer constants
+const int WORLD_SEED = 1; // Base noise seed; the five terrain layers use WORLD_SEED to WORLD_SEED + 4
 const int CONTINENT_OCTAVES = 4;
 const int TERRAIN_OCTAVES = 6;
 const int RIVER_OCTAVES = 2;
 const float RIVER_THRESHOLD = 0.82f;
 
+// Streamed (chunked) world constants
+const int CHUNK_SIZE = 32;              // Tiles per chunk side
+const int CHUNK_LOAD_RADIUS = 3;        // Chunks kept loaded around the player, in chunks
+const size_t CHUNK_MEMORY_BUDGET = 16u * 1024u * 1024u; // Bytes of resident chunk tiles before LRU eviction
+const size_t CHUNK_SPARE_LIMIT = 32;   // Evicted chunks kept for generation to reuse instead of allocating
+
+// Pre-rendered terrain constants
+// Terrain is baked in RENDER_CHUNK_SIZE square blocks rather than whole chunks: a 32x32 chunk
+// of 96x48 tiles would need a texture over 3000 pixels wide, past what many GPUs accept.
+const int RENDER_CHUNK_SIZE = 8;               // Tiles per baked texture side, divides CHUNK_SIZE
+const int RENDER_CHUNK_CACHE_TEXTURES = 64;    // Baked textures kept before the least recently drawn is freed
+
+// Zoom and terrain level-of-detail constants
+const float MIN_ZOOM = 1.0f / 64.0f;  // About 850 tiles across the screen
+const float MAX_ZOOM = 2.0f;
+const float ZOOM_STEP = 1.25f;         // Zoom factor per key press
+const float STREAMED_MIN_ZOOM = 0.5f;  // Streamed chunks have no LOD levels, so they stop here
+const int TERRAIN_LOD_LEVELS = 7;      // Cells of 1x1 up to 64x64 tiles, matching MIN_ZOOM
+
+// Frame profiler constants
+const int PROFILER_HISTORY_FRAMES = 240; // Frames kept for the F3 frame-time graph and CSV dump
+
+// Idle frame skipping constants
+const float FRAME_SKIP_TOLERANCE_PX = 0.25f; // Camera or player movement below this on screen is not redrawn
+const int IDLE_WAIT_MS = 250;                // Longest sleep for input while nothing on screen changes
+const int IDLE_STREAM_WAIT_MS = 16;          // Shorter while streamed chunks are still on their way
+
+// Telemetry constants
+const double TELEMETRY_FLUSH_SECONDS = 1.0; // Seconds between metric lines from the logger thread
+
 #endif // GAMECONSTANTS_H
@@ -0,0 +1,51 @@
+#ifndef INPUTREPLAY_H
+#define INPUTREPLAY_H
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+
+// Keyboard input of one frame
+struct InputFrame {
+    double seconds = 0.0;             // Real time the frame covered, as the fixed-step clock measured it
+    std::vector<SDL_Scancode> held;   // Keys down while the frame simulated
+    std::vector<SDL_Keycode> pressed; // SDL_KEYDOWN events of the frame in order, repeats included
+
+    bool operator==(const InputFrame& other) const {
+        return seconds == other.seconds && held == other.held && pressed == other.pressed;
+    }
+};
+
+// Recorded input of a whole run, replayed frame by frame.
+// A replayed frame feeds its pressed keys to the same handlers as live key presses, its held
+// keys to movement in place of SDL_GetKeyboardState, and its seconds to the fixed-step
+// clock. The simulation then runs the same steps and the camera takes the same path,
+// however long each replayed frame takes to draw.
+// Text file with one line per run of identical frames:
+//   <count> <seconds> [held keys] [| pressed keys]
+// Keys are SDL key names with spaces written as underscores (W, Space, Left_Shift, F3), or
+// 0x-prefixed raw codes, separated by whitespace; lines starting with # are comments. This
+// keeps scripted flythroughs easy to write by hand, e.g.
+//   1 0.0166667 | F3
+//   120 0.0166667 W D
+class InputRecording {
+public:
+    void Append(const InputFrame& frame) { frames.push_back(frame); }
+    void Clear() { frames.clear(); }
+    size_t FrameCount() const { return frames.size(); }
+    const InputFrame& Frame(size_t index) const { return frames[index]; }
+
+    // Both return false and print the reason to std::cerr on failure
+    bool Save(const std::string& path) const;
+    bool Load(const std::string& path);
+
+private:
+    std::vector<InputFrame> frames;
+};
+
+// Records the keys down in an SDL_GetKeyboardState array into frame.held
+void CaptureHeldKeys(const Uint8* keyState, InputFrame& frame);
+// Sizes keyState like SDL_GetKeyboardState's array and sets only frame's held keys
+void FillKeyState(const InputFrame& frame, std::vector<Uint8>& keyState);
+
+#endif // INPUTREPLAY_H
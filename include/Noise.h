@@ -6,7 +6,58 @@
 #include <random>
 #include <algorithm> // Required for std::shuffle
 
+// Kernels available for batch evaluation. Auto picks the widest one the CPU supports;
+// every kernel produces bit-identical results to the scalar Layered() call.
+enum class NoiseKernel {
+    Auto,
+    Scalar,
+    AVX2, // x86-64, 8 samples per instruction, selected at runtime
+    NEON  // AArch64, 4 samples per instruction
+};
+
+// Best kernel supported by the running CPU (never returns Auto)
+NoiseKernel ActiveNoiseKernel();
+const char* NoiseKernelName(NoiseKernel kernel);
+
+// Seeded Perlin noise source.
+// All permutation tables are built once in the constructor and never modified
+// afterwards, so a single NoiseGenerator can be shared by any number of threads.
+// Seeds follow the same convention as the free LayeredNoise function: octave i of
+// a layered sample taken with seed s reads the table for seed s + i.
+class NoiseGenerator {
+public:
+    // Builds one permutation table for every seed in [firstSeed, firstSeed + seedCount).
+    NoiseGenerator(int firstSeed, int seedCount);
+
+    float Perlin(float x, float y, int seed) const;
+    float Layered(float x, float y, int octaves, float persistence, float scale, int seed) const;
+
+    // Batch form of Layered() for samples sharing one y coordinate:
+    // out[i] = Layered(xs[i], y, octaves, persistence, scale, seed) for i in [0, count).
+    void LayeredRow(const float* xs, float y, int count, int octaves, float persistence, float scale,
+                    int seed, float* out, NoiseKernel kernel = NoiseKernel::Auto) const;
+    // Same as LayeredRow for evenly spaced samples x0 + i * dx
+    void LayeredRow(float x0, float dx, float y, int count, int octaves, float persistence, float scale,
+                    int seed, float* out, NoiseKernel kernel = NoiseKernel::Auto) const;
+
+    int FirstSeed() const { return firstSeed; }
+    int SeedCount() const { return static_cast<int>(tables.size() / 512); }
+    bool HasSeed(int seed) const { return seed >= firstSeed && seed < firstSeed + SeedCount(); }
+
+private:
+    const int* Table(int seed) const { return tables.data() + static_cast<size_t>(seed - firstSeed) * 512; }
+
+    int firstSeed;
+    std::vector<int> tables; // seedCount tables of 512 entries (256 shuffled + duplicate), back to back
+};
+
+// Fills p[0..511] with the permutation for the given seed (256 shuffled entries, repeated once).
+void BuildPermutation(int seed, int* p);
+
 // Function declarations for noise generation
+// These are convenience wrappers kept for existing callers. They cache the table of the
+// last seed per thread, so alternating seeds still pays for a reshuffle on every call;
+// hot paths should hold a NoiseGenerator instead.
 float PerlinNoise(float x, float y, int seed);
 float LayeredNoise(float x, float y, int octaves, float persistence, float scale, int seed);
 
@@ -5,8 +5,16 @@
 #include <vector>
 #include "DataTypes.h"
 #include "GameConstants.h"
+#include "TerrainSource.h"
 
 // Function declaration for player movement
-void HandlePlayerMovement(Player& player, const Uint8* keystate, float deltaTime, const std::vector<std::vector<Tile>>& world);
+// Advances the player by deltaTime seconds. Every rate is scaled by deltaTime, so the motion
+// converges as the step shrinks, but jumps are integrated with semi-implicit Euler and their
+// height still varies slightly with the step; the main loop calls this with a fixed step.
+void HandlePlayerMovement(Player& player, const Uint8* keystate, float deltaTime, const TerrainSource& world);
+
+// Render state between two simulation steps: position and elevation blended by alpha in [0, 1],
+// everything else taken from current
+Player InterpolatePlayer(const Player& previous, const Player& current, float alpha);
 
 #endif // PLAYER_H
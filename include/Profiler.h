@@ -0,0 +1,100 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <SDL2/SDL.h>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "GameConstants.h" // For PROFILER_HISTORY_FRAMES
+
+// Parts of a frame timed by the profiler, in the order the main loop runs them
+enum class ProfilePhase {
+    Events,     // SDL_PollEvent loop
+    Movement,   // HandlePlayerMovement and UpdateEntities
+    Camera,     // Camera::update
+    Culling,    // ComputeVisibleTiles
+    Submission, // Tile batching and the geometry draw
+    Player,     // Entity batch and RenderPlayer
+    Overlay,    // Debug overlay, including the profiler itself
+    Present,    // SDL_RenderPresent, which includes any vsync wait
+    Count
+};
+
+const char* ProfilePhaseName(ProfilePhase phase);
+
+// Timings and tile counts of one frame
+struct FrameSample {
+    double phaseMs[static_cast<int>(ProfilePhase::Count)] = {};
+    double frameMs = 0.0; // BeginFrame to EndFrame, so time outside the phases shows up here
+    int tilesVisited = 0;
+    int tilesDrawn = 0;
+};
+
+// Ring buffer of the last frames with per-phase timings.
+// The main loop brackets each frame with BeginFrame/EndFrame and wraps each phase in a
+// ScopedPhaseTimer. Times come from SDL_GetPerformanceCounter.
+class FrameProfiler {
+public:
+    explicit FrameProfiler(int historyFrames = PROFILER_HISTORY_FRAMES);
+
+    void BeginFrame();
+    void AddPhaseTime(ProfilePhase phase, double ms);
+    void SetTileCounts(int visited, int drawn);
+    void EndFrame();
+
+    int FrameCount() const { return count; }
+    // age 0 is the most recent finished frame
+    const FrameSample& Frame(int age) const;
+    // Mean of every frame in the history
+    FrameSample Average() const;
+
+    // Writes the history oldest first, one frame per line; returns false if the file can't be written
+    bool DumpCsv(const std::string& path) const;
+    // Frame-time graph with one stacked column per frame, plus per-phase and tile count bars
+    void Draw(SDL_Renderer* renderer, int x, int y) const;
+
+    static double TicksToMs(Uint64 ticks);
+
+private:
+    std::vector<FrameSample> frames;
+    int next = 0;  // Slot the next finished frame goes into
+    int count = 0; // Valid frames, up to frames.size()
+    FrameSample current;
+    Uint64 frameStart = 0;
+};
+
+// Distribution of one timing over a run of frames, in ms
+struct TimingPercentiles {
+    double mean = 0.0;
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+// Nearest-rank percentiles; all zero for no values
+TimingPercentiles ComputePercentiles(std::vector<double> values);
+
+// Writes frame time and per-phase percentiles of every given frame as JSON, for comparing
+// runs of the same replayed input. Unlike the profiler history this covers a whole run.
+void WriteFrameReport(const std::vector<FrameSample>& frames, std::ostream& out);
+
+// Adds the time between construction and destruction to one phase of the current frame
+class ScopedPhaseTimer {
+public:
+    ScopedPhaseTimer(FrameProfiler& profiler, ProfilePhase phase)
+        : profiler(profiler), phase(phase), start(SDL_GetPerformanceCounter()) {}
+    ~ScopedPhaseTimer() {
+        profiler.AddPhaseTime(phase, FrameProfiler::TicksToMs(SDL_GetPerformanceCounter() - start));
+    }
+
+    ScopedPhaseTimer(const ScopedPhaseTimer&) = delete;
+    ScopedPhaseTimer& operator=(const ScopedPhaseTimer&) = delete;
+
+private:
+    FrameProfiler& profiler;
+    ProfilePhase phase;
+    Uint64 start;
+};
+
+#endif // PROFILER_H
@@ -2,15 +2,114 @@
 #define RENDERER_H
 
 #include <SDL2/SDL.h>
+#include <cstdint>
+#include <vector>
 #include "DataTypes.h" // For Tile, Player, Camera
+#include "Entities.h"
+#include "TerrainSource.h"
+#include "Visibility.h"
 #include "GameConstants.h" // For SCREEN_WIDTH, SCREEN_HEIGHT, TILE_WIDTH etc.
 
 // Forward declare Player and Camera if their full definitions are not strictly needed in this header
 // However, they are used as parameters by const reference, so full definition via DataTypes.h is fine.
 
 // Function declarations for rendering operations
-void WorldToScreen(float worldX, float worldY, float elevation, int& screenX, int& screenY, const Camera& camera, const Player& player);
-void RenderTile(SDL_Renderer* renderer, const Tile& tile, const Camera& camera, const Player& player);
+// Projects through the camera: scaled by its zoom, then two subtractions of its offset
+void WorldToScreen(float worldX, float worldY, float elevation, int& screenX, int& screenY, const Camera& camera);
+void RenderTile(SDL_Renderer* renderer, const Tile& tile, const Camera& camera);
+
+// Incremental projection along one world row.
+// Stepping x by one tile moves the screen position by a constant (W/2, H/2) * zoom, so a
+// span of tiles needs one full projection at its first tile and a multiply-add per tile
+// after that; only the elevation term differs between tiles. Results agree with
+// WorldToScreen up to float rounding at the truncation boundary.
+struct RowProjection {
+    float originX = 0;        // screen position of the span's first tile at elevation 0
+    float originY = 0;
+    float stepX = 0;          // per tile along the row
+    float stepY = 0;
+    float elevationScale = 1; // screen pixels per elevation unit
+
+    // i is the tile's index from the first tile of the span
+    int ScreenX(int i) const { return static_cast<int>(originX + i * stepX); }
+    int ScreenY(int i, float elevation) const {
+        return static_cast<int>(originY + i * stepY - elevation * elevationScale);
+    }
+    // Projects count tiles from the first with elevations elevation[0..count); the loop has
+    // no branches or calls so it vectorizes
+    void Project(const int16_t* elevation, int count, int* screenX, int* screenY) const;
+};
+
+// Per-frame projection state: the camera terms are folded once, rows are derived from them
+class RowProjector {
+public:
+    explicit RowProjector(const Camera& camera);
+
+    // Projection of the span of row y that starts at tile firstX. Anchoring at the span
+    // keeps the incremental terms small even far from the world origin.
+    RowProjection Row(int y, int firstX) const;
+
+private:
+    float halfW;  // TILE_WIDTH / 2 * zoom
+    float halfH;  // TILE_HEIGHT / 2 * zoom
+    float zoom;
+    float cameraX;
+    float cameraY;
+};
 void RenderPlayer(SDL_Renderer* renderer, const Player& player, const Camera& camera);
 
+// Draws entities as small figures in the player's style, body and head outlined, with one
+// SDL_RenderGeometry call. Entities are drawn back to front (smaller x + y first, lower
+// elevation first on ties) so nearer ones overlap farther ones. Like the player, figures
+// keep their size at any zoom.
+class EntityBatch {
+public:
+    // Projects the entities alpha of the way from their previous to their current position,
+    // drops those off screen and sorts the rest; returns how many are left to draw
+    int Build(const EntityStore& entities, float alpha, const Camera& camera);
+    void Draw(SDL_Renderer* renderer) const;
+
+    size_t EntityCount() const { return sprites.size(); }
+
+private:
+    struct Sprite {
+        float depth;
+        float elevation;
+        float screenX;
+        float screenY;
+        SDL_Color color;
+    };
+    void AddQuad(float left, float top, float width, float height, SDL_Color color);
+
+    std::vector<Sprite> sprites;
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+};
+
+// Collects every tile drawn in a frame into one vertex/index buffer and submits it with a
+// single SDL_RenderGeometry call. Each tile is an outline-colored diamond with the fill
+// diamond inset on top of it, so outline and fill share the same draw. Tiles are drawn in
+// the order they were added, which keeps the painter's ordering of the caller's loop.
+class TileBatch {
+public:
+    void Clear();
+    // screenX/screenY is the tile center as returned by WorldToScreen; scale is the camera zoom
+    void AddTile(int screenX, int screenY, SDL_Color color, float scale = 1.0f);
+    // Projects and culls the tile; returns false if it was off screen
+    bool AddTile(const Tile& tile, const Camera& camera);
+    void Draw(SDL_Renderer* renderer) const;
+
+    size_t TileCount() const { return vertices.size() / 8; }
+
+private:
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+};
+
+// Adds every on-screen tile of the visible range to the batch, walking each row span one
+// terrain block (grid or chunk) at a time. Tiles of blocks that are not resident are drawn
+// as flat placeholders. Returns the number of tiles visited.
+int BatchVisibleTiles(const TerrainSource& terrain, const VisibleTileRange& visible,
+                      const Camera& camera, TileBatch& batch);
+
 #endif // RENDERER_H
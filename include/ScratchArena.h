@@ -0,0 +1,91 @@
+#ifndef SCRATCHARENA_H
+#define SCRATCHARENA_H
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+#include "WorldGrid.h"
+
+// Linear allocator for short-lived generation buffers.
+// Allocations bump an offset through a cache-line aligned block and are all released
+// together by Reset(); nothing is freed individually and no constructors or destructors
+// run, so only trivial types are accepted and their contents start out unspecified.
+// A cycle that outgrows the block chains extra blocks until the next Reset(), which then
+// replaces them with one block big enough for the whole cycle. A worker generating chunks
+// of a fixed size therefore stops touching the heap after its first chunk.
+// Not thread safe: each thread owns its own arena.
+class ScratchArena {
+public:
+    explicit ScratchArena(std::size_t initialBytes = 0) {
+        if (initialBytes > 0) AddBlock(initialBytes);
+    }
+
+    ScratchArena(const ScratchArena&) = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+
+    // Uninitialized space for count values, 64-byte aligned, valid until Reset()
+    template <typename T>
+    T* Allocate(std::size_t count) {
+        static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>,
+                      "ScratchArena never runs constructors or destructors");
+        return reinterpret_cast<T*>(AllocateBytes(count * sizeof(T)));
+    }
+
+    // Uninitialized width x height grid view with the same row layout WorldGrid would use
+    template <typename T>
+    WorldGrid<T> Grid(int width, int height, bool alignRows = true) {
+        const std::size_t stride = WorldGrid<T>::RowStride(width, alignRows);
+        T* cells = Allocate<T>(stride * static_cast<std::size_t>(std::max(height, 0)));
+        return WorldGrid<T>::View(cells, width, height, stride);
+    }
+
+    // Releases every allocation at once
+    void Reset() {
+        if (blocks.size() > 1) {
+            // Next cycle of the same shape fits in a single block
+            const std::size_t needed = cycleBytes;
+            blocks.clear();
+            AddBlock(needed);
+        }
+        used = 0;
+        cycleBytes = 0;
+    }
+
+    std::size_t Capacity() const {
+        std::size_t total = 0;
+        for (const Block& block : blocks) total += block.size();
+        return total;
+    }
+    std::size_t HeapAllocations() const { return heapAllocations; } // Blocks allocated so far
+
+private:
+    using Block = std::vector<unsigned char, AlignedAllocator<unsigned char>>;
+    static constexpr std::size_t kAlignment = 64;
+    static constexpr std::size_t kMinBlockBytes = 64 * 1024;
+
+    unsigned char* AllocateBytes(std::size_t bytes) {
+        bytes = (bytes + kAlignment - 1) / kAlignment * kAlignment;
+        if (blocks.empty() || used + bytes > blocks.back().size()) {
+            AddBlock(bytes);
+        }
+        unsigned char* p = blocks.back().data() + used;
+        used += bytes;
+        cycleBytes += bytes;
+        return p;
+    }
+
+    void AddBlock(std::size_t minBytes) {
+        const std::size_t size = std::max({minBytes, kMinBlockBytes, blocks.empty() ? 0 : blocks.back().size() * 2});
+        blocks.emplace_back(size);
+        used = 0;
+        ++heapAllocations;
+    }
+
+    std::vector<Block> blocks;   // Allocation happens in blocks.back()
+    std::size_t used = 0;        // Bytes handed out from blocks.back()
+    std::size_t cycleBytes = 0;  // Bytes handed out since the last Reset(), over every block
+    std::size_t heapAllocations = 0;
+};
+
+#endif // SCRATCHARENA_H
@@ -0,0 +1,51 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// Bounded lock-free queue for exactly one producer thread and one consumer thread.
+// Neither side ever blocks: TryPush fails when the queue is full and TryPop when it
+// is empty. One slot is kept free to tell full from empty, so capacity - 1 items fit.
+template <typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(size_t capacity) : slots(capacity < 2 ? 2 : capacity) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producer side
+    bool TryPush(T&& value) {
+        const size_t tail = tailIndex.load(std::memory_order_relaxed);
+        const size_t next = Next(tail);
+        if (next == headIndex.load(std::memory_order_acquire)) {
+            return false; // Full
+        }
+        slots[tail] = std::move(value);
+        tailIndex.store(next, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side
+    bool TryPop(T& out) {
+        const size_t head = headIndex.load(std::memory_order_relaxed);
+        if (head == tailIndex.load(std::memory_order_acquire)) {
+            return false; // Empty
+        }
+        out = std::move(slots[head]);
+        headIndex.store(Next(head), std::memory_order_release);
+        return true;
+    }
+
+private:
+    size_t Next(size_t index) const { return index + 1 == slots.size() ? 0 : index + 1; }
+
+    std::vector<T> slots;
+    // Producer and consumer indices live on separate cache lines to avoid false sharing
+    alignas(64) std::atomic<size_t> headIndex{0};
+    alignas(64) std::atomic<size_t> tailIndex{0};
+};
+
+#endif // SPSCQUEUE_H
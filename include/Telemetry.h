@@ -0,0 +1,99 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <atomic>
+#include <cstdint>
+#include "GameConstants.h" // For TELEMETRY_FLUSH_SECONDS
+
+// Telemetry is compiled in unless NDEBUG is defined, as it is in CMake's Release builds.
+// Define TELEMETRY_ENABLED to 0 or 1 to override. When it is 0 every call below is an empty
+// inline function, TELEMETRY_LOG does not even evaluate its arguments, and no logger
+// thread exists.
+#ifndef TELEMETRY_ENABLED
+#ifdef NDEBUG
+#define TELEMETRY_ENABLED 0
+#else
+#define TELEMETRY_ENABLED 1
+#endif
+#endif
+
+// Severity of messages and metrics; the logger prints those at or above its level
+enum class LogLevel : uint8_t {
+    Debug,
+    Info,
+    Warning,
+    Error,
+    Off
+};
+
+// Parses "debug", "info", "warning", "error" or "off"; returns false for anything else
+bool ParseLogLevel(const char* text, LogLevel& out);
+
+// Running total, updated in place from any thread without locking
+class TelemetryCounter {
+public:
+#if TELEMETRY_ENABLED
+    void Add(int64_t amount = 1) { value.fetch_add(amount, std::memory_order_relaxed); }
+    int64_t Value() const { return value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<int64_t> value{0};
+#else
+    void Add(int64_t = 1) {}
+    int64_t Value() const { return 0; }
+#endif
+};
+
+// Latest value of a quantity, set in place from any thread without locking
+class TelemetryGauge {
+public:
+#if TELEMETRY_ENABLED
+    void Set(double newValue) { value.store(newValue, std::memory_order_relaxed); }
+    double Value() const { return value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<double> value{0.0};
+#else
+    void Set(double) {}
+    double Value() const { return 0.0; }
+#endif
+};
+
+// Process-wide metrics and a background logger.
+// Register* returns the metric with that name, creating it on first use; references stay
+// valid for the rest of the run, so callers look metrics up once (typically into a static)
+// and only touch the atomic afterwards. Messages are formatted into a fixed-size slot of a
+// bounded queue and printed by the logger thread, which also prints one line with every
+// metric at or above its level each flush interval. Nothing on the calling side waits on
+// I/O; when the queue is full, messages are dropped and counted instead.
+#if TELEMETRY_ENABLED
+TelemetryCounter& RegisterCounter(const char* name, LogLevel level = LogLevel::Debug);
+TelemetryGauge& RegisterGauge(const char* name, LogLevel level = LogLevel::Debug);
+// Starts the logger thread. Metrics and messages before this are kept, not lost.
+void StartTelemetry(LogLevel level, double flushSeconds = TELEMETRY_FLUSH_SECONDS);
+// Prints whatever is still queued, then joins the logger thread
+void StopTelemetry();
+// printf-style message; cheap to call below the logger level. Use TELEMETRY_LOG instead.
+void TelemetryLog(LogLevel level, const char* format, ...)
+#if defined(__GNUC__)
+    __attribute__((format(printf, 2, 3)))
+#endif
+    ;
+
+#define TELEMETRY_LOG(level, ...) TelemetryLog(level, __VA_ARGS__)
+#else
+inline TelemetryCounter& RegisterCounter(const char*, LogLevel = LogLevel::Debug) {
+    static TelemetryCounter unused;
+    return unused;
+}
+inline TelemetryGauge& RegisterGauge(const char*, LogLevel = LogLevel::Debug) {
+    static TelemetryGauge unused;
+    return unused;
+}
+inline void StartTelemetry(LogLevel, double = TELEMETRY_FLUSH_SECONDS) {}
+inline void StopTelemetry() {}
+
+#define TELEMETRY_LOG(level, ...) ((void)0)
+#endif
+
+#endif // TELEMETRY_H
@@ -0,0 +1,45 @@
+#ifndef TERRAINLOD_H
+#define TERRAINLOD_H
+
+#include <memory>
+#include <vector>
+#include "DataTypes.h"     // For Camera
+#include "GameConstants.h" // For TERRAIN_LOD_LEVELS
+#include "TerrainSource.h"
+#include "WorldTiles.h"
+
+// Level-of-detail pyramid for zoomed-out views of a fixed-size world.
+// Level k aggregates 2^k x 2^k tiles into one cell with their mean elevation and color,
+// so each level halves the cells per side. A cell's elevation is stored divided by 2^k:
+// with LevelCamera() a level then projects like an ordinary world whose tiles are 2^k times
+// larger, and the usual visibility and TileBatch paths draw it unchanged. The renderer
+// picks the level whose cells are between half and one full tile on screen, which keeps
+// the number of primitives about constant at any zoom.
+class TerrainLod {
+public:
+    // world must outlive the pyramid; level 0 is the world itself
+    explicit TerrainLod(const WorldTiles& world, int maxLevels = TERRAIN_LOD_LEVELS);
+
+    TerrainLod(const TerrainLod&) = delete;
+    TerrainLod& operator=(const TerrainLod&) = delete;
+
+    // Recomputes the cells covering tiles [minX, maxX] x [minY, maxY] after they were edited
+    void Update(int minX, int minY, int maxX, int maxY);
+
+    int LevelCount() const { return static_cast<int>(sources.size()); }
+    // Coarsest level whose cells are at least half a tile wide on screen at zoom
+    int LevelForZoom(float zoom) const;
+    const TerrainSource& Level(int level) const { return *sources[level]; }
+
+    // Camera that projects cells of level onto the same pixels camera puts their tiles at
+    static Camera LevelCamera(const Camera& camera, int level);
+
+private:
+    void BuildCells(int level, int minX, int minY, int maxX, int maxY);
+
+    const WorldTiles& world;
+    std::vector<WorldTiles> levels;                          // levels[k - 1] holds level k
+    std::vector<std::unique_ptr<WorldTilesSource>> sources;  // one per level, 0 included
+};
+
+#endif // TERRAINLOD_H
@@ -0,0 +1,71 @@
+#ifndef TERRAINQUERY_H
+#define TERRAINQUERY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "TerrainSource.h"
+#include "WorldGrid.h"
+#include "WorldTiles.h"
+
+// Ground and collision queries shared by the player and any other moving entity.
+// Continuous positions use the same convention as movement: tile (x, y) covers
+// [x, x + 1) x [y, y + 1).
+
+// Terrain height at a continuous position, bilinear between tile centers.
+// Tiles that are not resident count as INITIAL_ELEVATION, like TerrainSource::ElevationAt.
+float HeightAt(const TerrainSource& terrain, float x, float y);
+
+// HeightAt for count positions. Neighbouring queries usually land in the same block, so
+// the block lookup is reused between them.
+void HeightsAt(const TerrainSource& terrain, const float* xs, const float* ys, float* heights, size_t count);
+
+// True when every tile the segment (x0, y0) -> (x1, y1) passes through is walkable and
+// resident, endpoints included
+bool SegmentWalkable(const TerrainSource& terrain, float x0, float y0, float x1, float y1);
+
+// SegmentWalkable for count segments; walkable[i] is 1 or 0
+void SegmentsWalkable(const TerrainSource& terrain, const float* x0s, const float* y0s,
+                      const float* x1s, const float* y1s, uint8_t* walkable, size_t count);
+
+// Elevation bounds of a square group of tiles
+struct ElevationSpan {
+    int16_t min;
+    int16_t max;
+};
+
+// Min/max elevation pyramid over a fixed-size world for ray and line-of-sight queries.
+// Level k stores the bounds of 2^k x 2^k tile blocks; level 0 is the tile grid itself and
+// is read from the world. A ray descends only into blocks whose maximum it passes below,
+// so queries over open or flat regions cost O(log n) block tests instead of one per tile.
+// Tiles are flat-topped prisms of their elevation.
+class ElevationPyramid {
+public:
+    // world must outlive the pyramid
+    explicit ElevationPyramid(const WorldTiles& world);
+
+    // Rebuilds the bounds above tiles [minX, maxX] x [minY, maxY] after they were edited
+    void Update(int minX, int minY, int maxX, int maxY);
+
+    // Parameter t in [0, 1] at which the segment (x0, y0, z0) -> (x1, y1, z1) first goes
+    // below the terrain, or a negative value when it never does. Parts of the segment
+    // outside the world do not hit anything.
+    float Raycast(float x0, float y0, float z0, float x1, float y1, float z1) const;
+
+    bool LineOfSight(float x0, float y0, float z0, float x1, float y1, float z1) const {
+        return Raycast(x0, y0, z0, x1, y1, z1) < 0.0f;
+    }
+
+    int LevelCount() const { return static_cast<int>(levels.size()) + 1; }
+    // Bounds of block (bx, by) at level, which covers 2^level tiles per side
+    ElevationSpan Span(int level, int bx, int by) const;
+
+private:
+    struct Segment;
+    float Trace(const Segment& segment, int level, int bx, int by, float tBegin, float tEnd) const;
+
+    const WorldTiles& world;
+    std::vector<WorldGrid<ElevationSpan>> levels; // levels[k - 1] holds level k
+};
+
+#endif // TERRAINQUERY_H
@@ -0,0 +1,80 @@
+#ifndef TERRAINSOURCE_H
+#define TERRAINSOURCE_H
+
+#include <algorithm>
+#include <climits>
+#include "WorldTiles.h"
+
+// Lowest and highest tile elevation in a world, used to bound the vertical projection offset
+struct ElevationRange {
+    int min = 0;
+    int max = 0;
+};
+
+ElevationRange ComputeElevationRange(const WorldTiles& world);
+
+// Tile index bounds of a world, maxX/maxY exclusive
+struct TileBounds {
+    int minX = INT_MIN / 4;
+    int minY = INT_MIN / 4;
+    int maxX = INT_MAX / 4;
+    int maxY = INT_MAX / 4;
+    bool bounded = false; // false: the world streams in forever in every direction
+};
+
+// A rectangular block of resident storage, or the extent of a block that is not resident.
+// Consumers walk a row span block by block and stream the block's SoA rows directly.
+struct TerrainBlock {
+    const WorldTiles* tiles = nullptr; // nullptr: outside the world or not generated yet
+    int originX = 0;                   // world position of the block's (0, 0) tile
+    int originY = 0;
+    int width = 1;                     // extent, also valid when tiles is nullptr
+    int height = 1;
+};
+
+// Chunk-aware read access to terrain, shared by movement and rendering so they work the
+// same on one fixed grid and on streamed chunks.
+class TerrainSource {
+public:
+    virtual ~TerrainSource() = default;
+
+    virtual TerrainBlock BlockAt(int x, int y) const = 0;
+    virtual TileBounds Bounds() const = 0;
+    // Elevation range of every tile that can be returned, for visibility padding
+    virtual ElevationRange ElevationBounds() const = 0;
+
+    bool HasTile(int x, int y) const { return BlockAt(x, y).tiles != nullptr; }
+    // Both return INITIAL_ELEVATION / false for tiles that are not resident
+    int ElevationAt(int x, int y) const {
+        TerrainBlock block = BlockAt(x, y);
+        return block.tiles ? block.tiles->elevation(x - block.originX, y - block.originY)
+                           : static_cast<int>(INITIAL_ELEVATION);
+    }
+    bool IsWalkableAt(int x, int y) const {
+        TerrainBlock block = BlockAt(x, y);
+        return block.tiles && block.tiles->IsWalkable(x - block.originX, y - block.originY);
+    }
+};
+
+// TerrainSource over a single fixed-size grid such as the one GenerateWorld returns
+class WorldTilesSource : public TerrainSource {
+public:
+    explicit WorldTilesSource(const WorldTiles& world)
+        : world(world), elevationRange(ComputeElevationRange(world)) {}
+
+    TerrainBlock BlockAt(int x, int y) const override;
+    TileBounds Bounds() const override { return {0, 0, world.Width(), world.Height(), true}; }
+    ElevationRange ElevationBounds() const override { return elevationRange; }
+    // Widens the cached range after tiles were edited; it never shrinks, which only
+    // over-pads visibility
+    void IncludeElevations(const ElevationRange& range) {
+        elevationRange.min = std::min(elevationRange.min, range.min);
+        elevationRange.max = std::max(elevationRange.max, range.max);
+    }
+
+private:
+    const WorldTiles& world;
+    ElevationRange elevationRange;
+};
+
+#endif // TERRAINSOURCE_H
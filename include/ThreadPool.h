@@ -0,0 +1,48 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed-size pool of worker threads for data-parallel loops.
+// ParallelFor splits a range into one contiguous band per thread and blocks until every
+// band is finished, so consecutive calls act as barriers between generation passes.
+class ThreadPool {
+public:
+    // threadCount includes the calling thread; 0 means one per hardware thread
+    explicit ThreadPool(unsigned threadCount);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned ThreadCount() const { return static_cast<unsigned>(workers.size()) + 1; }
+
+    // Runs body(bandBegin, bandEnd) over [begin, end) split into at most ThreadCount() bands.
+    // Band boundaries depend only on the range and the thread count.
+    // Only one thread may call ParallelFor on a given pool at a time.
+    void ParallelFor(int begin, int end, const std::function<void(int, int)>& body);
+
+private:
+    void WorkerLoop(unsigned workerIndex);
+    void RunBand(unsigned band);
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+
+    // Current job, guarded by mutex
+    const std::function<void(int, int)>* job = nullptr;
+    int jobBegin = 0;
+    int jobEnd = 0;
+    unsigned jobBands = 0;
+    unsigned pendingBands = 0;
+    unsigned long long generation = 0;
+    bool stopping = false;
+};
+
+#endif // THREADPOOL_H
@@ -0,0 +1,29 @@
+#ifndef VISIBILITY_H
+#define VISIBILITY_H
+
+#include <vector>
+#include "TerrainSource.h" // For ElevationRange, TileBounds
+
+// Tiles that can intersect the viewport, as one contiguous x span per world row.
+// The spans are conservative: every tile that passes the render loop's on-screen test is
+// inside them, and only a thin border of tiles outside the screen is included.
+struct VisibleTileRange {
+    int yBegin = 0;
+    int yEnd = 0;            // exclusive
+    std::vector<int> xBegin; // indexed by y - yBegin
+    std::vector<int> xEnd;   // exclusive, xEnd <= xBegin means the row is empty
+
+    int RowBegin(int y) const { return xBegin[y - yBegin]; }
+    int RowEnd(int y) const { return xEnd[y - yBegin]; }
+    int TileCount() const;
+};
+
+// Inverts the isometric projection used by WorldToScreen around the view center
+// (viewX, viewY, viewElevation) to find the tile index range, per row, that can land on
+// screen. elevation widens the vertical bounds by the possible elevation offset, with an
+// extra TILE_DEPTH of padding. zoom is the camera zoom the tiles are drawn at.
+// Spans are clipped to bounds. out keeps its storage between frames.
+void ComputeVisibleTiles(float viewX, float viewY, float viewElevation, ElevationRange elevation,
+                         const TileBounds& bounds, VisibleTileRange& out, float zoom = 1.0f);
+
+#endif // VISIBILITY_H
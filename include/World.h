@@ -1,15 +1,110 @@
 #ifndef WORLD_H
 #define WORLD_H
 
+#include <cstdint>
 #include <vector>
-#include <map>
 #include "DataTypes.h" // For Tile, BiomeType, BiomeProperties, TerrainData
+#include "WorldGrid.h" // For WorldGrid
+#include "ScratchArena.h" // For region generation scratch memory
+#include "WorldTiles.h" // For the SoA world returned by GenerateWorld
+#include "GameConstants.h" // For the WorldGenConfig defaults
 #include "Noise.h"     // For LayeredNoise, PerlinNoise (if directly used by world gen, though it seems LayeredNoise is the main interface)
 
+// Bump whenever a change alters generated terrain, so cached worlds are regenerated
+const uint32_t WORLD_GENERATOR_VERSION = 2;
+
+// Everything a generated world depends on. Worlds generated from equal configs are
+// identical tile for tile on any machine, thread count or tile storage; the defaults give
+// the world the GameConstants.h values describe. Noise coordinates are scaled by
+// WORLD_WIDTH/WORLD_HEIGHT whatever the size, so a fixed world of any size is the same
+// terrain a streamed world of that seed shows at those tiles; larger sizes extend it.
+// The biome levels stay compile-time constants: the biome lookup table is built from them.
+struct WorldGenConfig {
+    uint32_t seed = WORLD_SEED; // The five terrain layers use seed to seed + 4; also keys color jitter
+    int width = WORLD_WIDTH;
+    int height = WORLD_HEIGHT;
+    int continentOctaves = CONTINENT_OCTAVES;
+    int terrainOctaves = TERRAIN_OCTAVES;
+    int riverOctaves = RIVER_OCTAVES;
+    float riverThreshold = RIVER_THRESHOLD; // River noise above this is carved into water
+
+    // Checks ranges; on failure prints why to std::cerr and returns false
+    bool Validate() const;
+    bool operator==(const WorldGenConfig& other) const;
+    bool operator!=(const WorldGenConfig& other) const { return !(*this == other); }
+};
+
+// Stable 64-bit hash of every config field and WORLD_GENERATOR_VERSION, for keying caches
+// and pre-generated worlds
+uint64_t WorldGenConfigHash(const WorldGenConfig& config);
+// Stable 64-bit hash of a world's size, elevation, biome and walkable tiles. Colors follow
+// from the biome, position and seed, so Full and Compact worlds of one config hash the same.
+uint64_t WorldContentHash(const WorldTiles& world);
+
+// Time of each generation stage in milliseconds, filled in by GenerateWorld on request.
+// Stages run interleaved block by block on every thread; each is the longest wall time any
+// one thread spent in it. The slowest threads of different stages may differ, so the sum
+// can exceed the total wall time a little.
+struct WorldGenTimings {
+    double noiseMs = 0.0;    // Noise layers sampled into raw elevation, moisture and river values
+    double carveMs = 0.0;    // River and lake carving
+    double smoothMs = 0.0;   // Smoothing stencil
+    double classifyMs = 0.0; // Biome, walkability and color
+};
+
+// Water, land and mountain tile counts by stored elevation
+struct WorldStats {
+    int waterTiles = 0;    // Below WATER_LEVEL
+    int landTiles = 0;
+    int mountainTiles = 0; // Above MOUNTAIN_LEVEL
+
+    void Count(int16_t elevation);
+    void Add(const WorldStats& other);
+};
+
 // Function declarations for world generation and properties
-std::vector<std::vector<Tile>> GenerateWorld();
+// Generates the config.width x config.height world starting at tile (0, 0).
+// threadCount shares the world's generation blocks between threads (0 = one per hardware
+// thread). The generated world is identical for any thread count. Compact storage drops
+// the color array; every other field is the same. stats and timings, when not null,
+// receive the tile counts, gathered while the tiles are generated, and the stage times.
+WorldTiles GenerateWorld(const WorldGenConfig& config, unsigned threadCount = 1,
+                         TileStorage storage = TileStorage::Full, WorldStats* stats = nullptr,
+                         WorldGenTimings* timings = nullptr);
+// The default config's world
+WorldTiles GenerateWorld(unsigned threadCount = 1, TileStorage storage = TileStorage::Full,
+                         WorldStats* stats = nullptr);
+// The default config's terrain over width x height tiles. Used by benchmarks; timings and
+// stats may be null.
+WorldTiles GenerateWorld(unsigned threadCount, int width, int height, WorldGenTimings* timings = nullptr,
+                         TileStorage storage = TileStorage::Full, WorldStats* stats = nullptr);
+// Tile counts of an existing world, for worlds that were loaded rather than generated
+WorldStats ComputeWorldStats(const WorldTiles& world);
+// Generates the width x height block of the unbounded world of config whose (0, 0) tile is
+// the world tile (originX, originY); config's size is ignored. noise must come from
+// CreateWorldNoise(config). Used for chunks; tiles match GenerateWorld away from its edges.
+WorldTiles GenerateRegion(const WorldGenConfig& config, const NoiseGenerator& noise, int originX, int originY,
+                          int width, int height);
+// Same, but generates into tiles (whose size sets the region size, every tile is
+// overwritten) and takes all intermediate buffers from scratch. Nothing else is allocated,
+// so a caller reusing tiles and resetting scratch between regions stays off the heap.
+void GenerateRegion(const WorldGenConfig& config, const NoiseGenerator& noise, int originX, int originY,
+                    ScratchArena& scratch, WorldTiles& tiles);
+// Terrain after noise sampling and river carving but before smoothing, for the fixed
+// world of config. Together with RefreshTiles this lets edits redo only the later stages.
+WorldGrid<TerrainData> GenerateTerrainField(const WorldGenConfig& config, unsigned threadCount);
+// Marks a tile in a biome override grid as classified from elevation and moisture
+const BiomeType BIOME_NOT_OVERRIDDEN = static_cast<BiomeType>(0xFF);
+// Recomputes smoothing, biome, walkability and color of tiles [minX, maxX] x [minY, maxY]
+// (clipped to the world) from field, exactly as GenerateWorld would. Smoothing reads one
+// tile around each tile, so after changing field cells the rectangle should include a
+// one-tile halo. biomeOverride may be null; cells other than BIOME_NOT_OVERRIDDEN replace
+// the classified biome.
+void RefreshTiles(const WorldGrid<TerrainData>& field, const WorldGrid<BiomeType>* biomeOverride,
+                  WorldTiles& tiles, int minX, int minY, int maxX, int maxY);
+// Generator holding every seed the world layers of config use
+NoiseGenerator CreateWorldNoise(const WorldGenConfig& config = WorldGenConfig());
 BiomeType DetermineBiome(float elevation, float moisture); // Used by GenerateWorld
-std::map<BiomeType, BiomeProperties> CreateBiomeProperties(); // Used by GenerateWorld
 float GetTerrainHeight(float x, float y); // May or may not be used by GenerateWorld directly, but is world related
 
 #endif // WORLD_H
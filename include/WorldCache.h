@@ -0,0 +1,43 @@
+#ifndef WORLDCACHE_H
+#define WORLDCACHE_H
+
+#include <cstdint>
+#include <string>
+#include "World.h"      // For WorldGenConfig
+#include "WorldTiles.h"
+
+// Binary world cache
+// Layout: a fixed WorldCacheHeader followed by the elevation (int16), color (RGBA8),
+// walkable (64-bit words, (width + 63) / 64 per row) and biome (uint8) arrays. Rows are
+// tightly packed and every array starts on a 64-byte boundary, so a mapped file can be
+// used in place as a WorldTiles view. Compact worlds have no color array and store a
+// colorOffset of 0.
+const uint32_t WORLD_CACHE_FORMAT_VERSION = 2;
+
+struct WorldCacheHeader {
+    char magic[8];             // "DLWORLD\0"
+    uint32_t formatVersion;    // WORLD_CACHE_FORMAT_VERSION
+    uint32_t byteOrderMark;    // 0x01020304 as written by the producing machine
+    uint32_t generatorVersion; // WORLD_GENERATOR_VERSION of the generating build
+    uint32_t seed;
+    int32_t width;
+    int32_t height;
+    uint64_t configHash;       // WorldGenConfigHash of the config the world was generated from
+    uint64_t elevationOffset;
+    uint64_t colorOffset;
+    uint64_t walkableOffset;
+    uint64_t biomeOffset;
+    uint64_t fileSize;
+};
+
+// Writes world, generated from config, to path (through a temporary file renamed into
+// place). Returns false and prints the reason on failure.
+bool SaveWorldCache(const std::string& path, const WorldTiles& world, const WorldGenConfig& config);
+
+// Maps path read-only and exposes it as out, whose grids are views into the mapping.
+// Returns false, leaving out untouched, if the file is missing, truncated, or was written
+// for a different format, generator version, config or tile storage. The mapping is
+// private copy-on-write, so writing to out never modifies the file.
+bool LoadWorldCache(const std::string& path, const WorldGenConfig& config, TileStorage storage, WorldTiles& out);
+
+#endif // WORLDCACHE_H
@@ -0,0 +1,72 @@
+#ifndef WORLDEDIT_H
+#define WORLDEDIT_H
+
+#include "DataTypes.h" // For TerrainData, BiomeType
+#include "TerrainSource.h"
+#include "WorldGrid.h"
+#include "WorldTiles.h"
+#include "World.h" // For WorldGenConfig
+
+// Inclusive tile rectangle; empty when maxX < minX or maxY < minY
+struct TileRect {
+    int minX = 0;
+    int minY = 0;
+    int maxX = -1;
+    int maxY = -1;
+
+    bool Empty() const { return maxX < minX || maxY < minY; }
+};
+
+// Tiles an edit rewrote, and the elevation range found among them afterwards.
+// Callers pass tiles to ChunkTextureCache::Invalidate and elevation to
+// WorldTilesSource::IncludeElevations.
+struct TileEdit {
+    TileRect tiles;
+    ElevationRange elevation;
+};
+
+enum class BrushOp {
+    Raise,   // add amount, scaled by the falloff
+    Lower,   // subtract amount, scaled by the falloff
+    Flatten, // move towards the elevation amount, by the falloff
+    SetBiome // force biome on every tile inside the radius
+};
+
+// Round brush with linear falloff from 1 at the center to 0 at radius
+struct Brush {
+    int centerX = 0;
+    int centerY = 0;
+    int radius = 1;
+    BrushOp op = BrushOp::Raise;
+    float amount = 1.0f;
+    BiomeType biome = BiomeType::PLAINS;
+};
+
+// Edits a fixed-size world in place.
+// The editor keeps the unsmoothed terrain field the world was generated from. An edit
+// changes field cells, then runs smoothing and classification again for the changed
+// tiles plus the one-tile halo the smoothing stencil reaches, so the result is the same as
+// generating the edited field from scratch. The field is built on the first edit.
+class WorldEditor {
+public:
+    // world must be the GenerateWorld of config, generated or loaded from the cache, and
+    // outlive the editor
+    explicit WorldEditor(WorldTiles& world, const WorldGenConfig& config = WorldGenConfig(), unsigned threadCount = 0);
+
+    TileEdit SetElevation(int x, int y, float elevation);
+    TileEdit SetBiome(int x, int y, BiomeType biome);
+    TileEdit ApplyBrush(const Brush& brush);
+
+private:
+    void EnsureField();
+    // Refreshes the changed rectangle grown by the halo and reports it
+    TileEdit Refresh(const TileRect& changed);
+
+    WorldTiles& world;
+    WorldGenConfig config;
+    unsigned threadCount;
+    WorldGrid<TerrainData> field;
+    WorldGrid<BiomeType> biomeOverride; // BIOME_NOT_OVERRIDDEN where no biome was painted
+};
+
+#endif // WORLDEDIT_H
@@ -0,0 +1,140 @@
+#ifndef WORLDGRID_H
+#define WORLDGRID_H
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+// Minimal allocator handing out 64-byte (cache line) aligned blocks
+template <typename T, std::size_t Alignment = 64>
+struct AlignedAllocator {
+    using value_type = T;
+
+    AlignedAllocator() = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+    template <typename U>
+    struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+    }
+    void deallocate(T* p, std::size_t) {
+        ::operator delete(p, std::align_val_t(Alignment));
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const { return false; }
+};
+
+// Row-major 2D grid backed by a single cache-line aligned allocation.
+// With alignRows every row starts on a 64-byte boundary: the row stride is padded up to
+// the next element count whose byte size is a multiple of 64. Padding cells are value
+// initialized and never visited by the accessors.
+// A grid can also be a non-owning view over external memory (see View), used for worlds
+// memory-mapped from a cache file; whoever owns that memory must keep it alive.
+template <typename T>
+class WorldGrid {
+public:
+    WorldGrid() = default;
+    WorldGrid(int width, int height, bool alignRows = false)
+        : width(width), height(height), stride(ComputeStride(width, alignRows)),
+          cells(stride * static_cast<std::size_t>(height)), base(cells.data()) {}
+    WorldGrid(int width, int height, const T& value, bool alignRows = false)
+        : width(width), height(height), stride(ComputeStride(width, alignRows)),
+          cells(stride * static_cast<std::size_t>(height), value), base(cells.data()) {}
+
+    // Owned storage moves or copies with the grid; views keep pointing at the same memory
+    WorldGrid(const WorldGrid& other)
+        : width(other.width), height(other.height), stride(other.stride), cells(other.cells),
+          base(other.IsView() ? other.base : cells.data()) {}
+    // IsView reads other.cells, so it is asked before the cells move away
+    WorldGrid(WorldGrid&& other) noexcept : WorldGrid(std::move(other), other.IsView()) {}
+    WorldGrid& operator=(const WorldGrid& other) {
+        if (this != &other) {
+            WorldGrid copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+    WorldGrid& operator=(WorldGrid&& other) noexcept {
+        if (this != &other) {
+            const bool view = other.IsView();
+            width = other.width;
+            height = other.height;
+            stride = other.stride;
+            cells = std::move(other.cells);
+            base = view ? other.base : cells.data();
+            other.Reset();
+        }
+        return *this;
+    }
+
+    // Grid over width x height cells at data, rows stride elements apart. Not owning.
+    static WorldGrid View(T* data, int width, int height, std::size_t stride) {
+        WorldGrid grid;
+        grid.width = width;
+        grid.height = height;
+        grid.stride = stride;
+        grid.base = data;
+        return grid;
+    }
+
+    int Width() const { return width; }
+    int Height() const { return height; }
+    std::size_t Stride() const { return stride; }
+    bool IsView() const { return base != nullptr && cells.empty(); }
+
+    // Row stride in elements a width-cell grid gets, for placing views over external memory
+    static std::size_t RowStride(int width, bool alignRows) { return ComputeStride(width, alignRows); }
+
+    bool InBounds(int x, int y) const { return x >= 0 && x < width && y >= 0 && y < height; }
+
+    T& operator()(int x, int y) { return base[static_cast<std::size_t>(y) * stride + x]; }
+    const T& operator()(int x, int y) const { return base[static_cast<std::size_t>(y) * stride + x]; }
+
+    T* Row(int y) { return base + static_cast<std::size_t>(y) * stride; }
+    const T* Row(int y) const { return base + static_cast<std::size_t>(y) * stride; }
+
+    T* Data() { return base; }
+    const T* Data() const { return base; }
+
+    void Fill(const T& value) { std::fill(base, base + stride * static_cast<std::size_t>(height), value); }
+
+private:
+    static std::size_t ComputeStride(int width, bool alignRows) {
+        std::size_t w = static_cast<std::size_t>(width > 0 ? width : 0);
+        if (!alignRows) return w;
+        // Smallest element count whose byte size is a whole number of cache lines
+        std::size_t quantum = 64 / std::gcd<std::size_t, std::size_t>(64, sizeof(T));
+        return (w + quantum - 1) / quantum * quantum;
+    }
+
+    WorldGrid(WorldGrid&& other, bool view) noexcept
+        : width(other.width), height(other.height), stride(other.stride), cells(std::move(other.cells)),
+          base(view ? other.base : cells.data()) {
+        other.Reset();
+    }
+
+    void Reset() {
+        width = 0;
+        height = 0;
+        stride = 0;
+        cells.clear();
+        base = nullptr;
+    }
+
+    int width = 0;
+    int height = 0;
+    std::size_t stride = 0;
+    std::vector<T, AlignedAllocator<T>> cells;
+    T* base = nullptr; // cells.data() for owned grids, external memory for views
+};
+
+#endif // WORLDGRID_H
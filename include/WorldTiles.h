@@ -0,0 +1,77 @@
+#ifndef WORLDTILES_H
+#define WORLDTILES_H
+
+#include <cstdint>
+#include <memory>
+#include "Biomes.h"    // For TileColor
+#include "DataTypes.h" // For Tile, BiomeType
+#include "WorldGrid.h"
+
+// How much of a tile WorldTiles keeps in memory
+enum class TileStorage : uint8_t {
+    Full,   // elevation, biome, walkable bit and RGBA color: about 7 bytes per tile
+    Compact // no color array; ColorAt() derives it from the biome: about 3 bytes per tile
+};
+
+// Structure-of-arrays world storage.
+// Per-frame code reads only the field it needs: culling and rendering stream elevation and
+// color, movement streams elevation and the walkable bits. Tile coordinates are implied by
+// the grid index instead of being stored. GetTile() assembles the old AoS Tile for callers
+// that still want one. Compact storage leaves color empty.
+struct WorldTiles {
+    WorldTiles() = default;
+    WorldTiles(int width, int height, TileStorage storage = TileStorage::Full)
+        : elevation(width, height, true), biome(width, height, true),
+          walkable((width + 63) / 64, height, uint64_t(0)) {
+        if (storage == TileStorage::Full) color = WorldGrid<SDL_Color>(width, height, true);
+    }
+
+    int Width() const { return elevation.Width(); }
+    int Height() const { return elevation.Height(); }
+    bool InBounds(int x, int y) const { return elevation.InBounds(x, y); }
+
+    // Each row owns whole 64-bit words, so row bands can set bits without sharing a word
+    bool IsWalkable(int x, int y) const {
+        return (walkable(x >> 6, y) >> (x & 63)) & 1u;
+    }
+    void SetWalkable(int x, int y, bool isWalkable) {
+        uint64_t bit = uint64_t(1) << (x & 63);
+        uint64_t& word = walkable(x >> 6, y);
+        word = isWalkable ? (word | bit) : (word & ~bit);
+    }
+
+    bool StoresColor() const { return color.Width() == Width() && color.Height() == Height(); }
+    TileStorage Storage() const { return StoresColor() ? TileStorage::Full : TileStorage::Compact; }
+    // Color of tile (x, y), stored or decoded; (originX, originY) is the world position of
+    // tile (0, 0), which the decoded jitter depends on
+    SDL_Color ColorAt(int x, int y, int originX = 0, int originY = 0) const {
+        return StoresColor() ? color(x, y)
+                             : TileColor(biome(x, y), originX + x, originY + y, seed, worldWidth, worldHeight);
+    }
+
+    // Bytes held by the arrays, used for chunk memory budgets
+    size_t MemoryBytes() const {
+        return elevation.Stride() * Height() * sizeof(int16_t) + color.Stride() * Height() * sizeof(SDL_Color) +
+               biome.Stride() * Height() * sizeof(BiomeType) + walkable.Stride() * Height() * sizeof(uint64_t);
+    }
+
+    // AoS view kept for compatibility with Tile-based code
+    Tile GetTile(int x, int y) const {
+        return {x, y, elevation(x, y), ColorAt(x, y), IsWalkable(x, y)};
+    }
+
+    WorldGrid<int16_t> elevation;
+    WorldGrid<SDL_Color> color;
+    WorldGrid<BiomeType> biome;
+    WorldGrid<uint64_t> walkable; // One bit per tile, (width + 63) / 64 words per row
+    uint32_t seed = WORLD_SEED;   // Generation seed, which decoded colors are jittered by
+    // Size of the fixed world the tiles belong to, for the debug border and center lines of
+    // their colors; 0 for streamed chunks, whose world has neither
+    int worldWidth = 0;
+    int worldHeight = 0;
+
+    // Keeps external storage alive when the grids are views, e.g. a mapped cache file
+    std::shared_ptr<const void> backing;
+};
+
+#endif // WORLDTILES_H
@@ -1,24 +1,50 @@
 #include "../include/DataTypes.h"    // For Camera and Player struct definitions
 #include "../include/GameConstants.h"  // For TILE_WIDTH, TILE_HEIGHT, SCREEN_WIDTH, SCREEN_HEIGHT
-#include <SDL2/SDL.h>       // For SDL_GetTicks, Uint32
-#include <iostream>         // For std::cout (debug)
+#include <cmath>            // For std::pow, std::abs
+
+// Camera position that puts the world point (worldX, worldY, elevation) at the screen center
+static void CenteredPosition(float worldX, float worldY, float elevation, float zoom, float& x, float& y) {
+    // Convert the world position to screen space without camera offset
+    float screenX_world = (worldX - worldY) * (TILE_WIDTH / 2.0f) * zoom;
+    float screenY_world = ((worldX + worldY) * (TILE_HEIGHT / 2.0f) - elevation) * zoom;
+
+    x = screenX_world - (SCREEN_WIDTH / 2.0f); // Use floating point division
+    y = screenY_world - (SCREEN_HEIGHT / 2.0f); // Use floating point division
+}
+
+void Camera::snap(const Player& player) {
+    CenteredPosition(player.x, player.y, player.elevation, zoom, x, y);
+}
+
+bool Camera::settled(const Player& player, float tolerance) const {
+    float targetX, targetY;
+    CenteredPosition(player.x, player.y, player.elevation, zoom, targetX, targetY);
+    return std::abs(targetX - x) < tolerance && std::abs(targetY - y) < tolerance;
+}
 
 // Implementation for Camera::update method
-void Camera::update(const Player& player) {
-    // Convert player world position to screen space without camera offset
-    float screenX_player_world = (player.x - player.y) * (TILE_WIDTH / 2.0f);
-    float screenY_player_world = (player.x + player.y) * (TILE_HEIGHT / 2.0f) - player.elevation;
-
-    // Immediately set camera to center player (no smoothing)
-    // This ensures player is always perfectly centered
-    x = screenX_player_world - (SCREEN_WIDTH / 2.0f); // Use floating point division
-    y = screenY_player_world - (SCREEN_HEIGHT / 2.0f); // Use floating point division
-
-    // Debug - print less frequently to avoid console spam
-    static Uint32 lastCameraDebugTime = 0;
-    Uint32 currentTime = SDL_GetTicks();
-    if (currentTime - lastCameraDebugTime > 1000) { // Once per second
-        // std::cout << "Camera position (from Camera.cpp): (" << x << ", " << y << ")" << std::endl;
-        lastCameraDebugTime = currentTime;
-    }
+void Camera::update(const Player& player, float deltaTime) {
+    float targetX, targetY;
+    CenteredPosition(player.x, player.y, player.elevation, zoom, targetX, targetY);
+
+    // Exponential smoothing: CAMERA_FOLLOW_SPEED of the remaining distance per reference
+    // tick, scaled so that frame rate does not change how fast the camera catches up
+    const float follow = 1.0f - std::pow(1.0f - CAMERA_FOLLOW_SPEED, deltaTime * PHYSICS_REFERENCE_RATE);
+    x += (targetX - x) * follow;
+    y += (targetY - y) * follow;
+}
+
+void Camera::viewCenter(float elevation, float& worldX, float& worldY) const {
+    // Inverse of WorldToScreen at the screen center
+    const float d = (x + SCREEN_WIDTH / 2.0f) / (TILE_WIDTH / 2.0f * zoom);                      // worldX - worldY
+    const float s = ((y + SCREEN_HEIGHT / 2.0f) / zoom + elevation) / (TILE_HEIGHT / 2.0f); // worldX + worldY
+    worldX = (s + d) / 2.0f;
+    worldY = (s - d) / 2.0f;
+}
+
+void Camera::setZoom(float newZoom, float elevation) {
+    float centerX, centerY;
+    viewCenter(elevation, centerX, centerY);
+    zoom = newZoom;
+    CenteredPosition(centerX, centerY, elevation, zoom, x, y);
 }
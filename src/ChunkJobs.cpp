@@ -0,0 +1,131 @@
+#include "ChunkJobs.h"
+#include "ChunkManager.h"
+#include "World.h"
+#include <algorithm>
+#include <cstdlib>
+
+// Finished chunks a worker can have waiting before it stalls until the main thread drains
+static const size_t kResultQueueCapacity = 64;
+
+ChunkJobSystem::ChunkJobSystem(const WorldGenConfig& config, const NoiseGenerator& noise, unsigned workerCount)
+    : config(config), noise(noise) {
+    workerCount = std::max(1u, workerCount);
+    for (unsigned i = 0; i < workerCount; ++i) {
+        results.push_back(std::make_unique<SpscQueue<ChunkJobResult>>(kResultQueueCapacity));
+    }
+    for (unsigned i = 0; i < workerCount; ++i) {
+        workers.emplace_back(&ChunkJobSystem::WorkerLoop, this, i);
+    }
+}
+
+ChunkJobSystem::~ChunkJobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(requestMutex);
+        stopping = true;
+    }
+    requestReady.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void ChunkJobSystem::SetCenter(int chunkX, int chunkY, int radius) {
+    centerX.store(chunkX, std::memory_order_relaxed);
+    centerY.store(chunkY, std::memory_order_relaxed);
+    keepRadius.store(radius, std::memory_order_relaxed);
+}
+
+bool ChunkJobSystem::TryRequest(const std::vector<std::pair<int, int>>& chunkCoords) {
+    if (chunkCoords.empty()) return true;
+    std::unique_lock<std::mutex> lock(requestMutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return false;
+    }
+    pending.insert(pending.end(), chunkCoords.begin(), chunkCoords.end());
+    lock.unlock();
+    requestReady.notify_all();
+    return true;
+}
+
+bool ChunkJobSystem::TryRecycle(std::vector<std::unique_ptr<Chunk>>& chunks) {
+    if (chunks.empty()) return true;
+    std::unique_lock<std::mutex> lock(requestMutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return false;
+    }
+    while (!chunks.empty() && spareChunks.size() < CHUNK_SPARE_LIMIT) {
+        spareChunks.push_back(std::move(chunks.back()));
+        chunks.pop_back();
+    }
+    return true;
+}
+
+bool ChunkJobSystem::TryPopResult(ChunkJobResult& out) {
+    // Round-robin over the worker queues so one busy worker cannot starve the others
+    for (size_t i = 0; i < results.size(); ++i) {
+        SpscQueue<ChunkJobResult>& queue = *results[nextResultQueue];
+        nextResultQueue = (nextResultQueue + 1) % static_cast<unsigned>(results.size());
+        if (queue.TryPop(out)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Called with requestMutex held
+bool ChunkJobSystem::TakeClosestRequest(int& chunkX, int& chunkY, bool& stale) {
+    if (pending.empty()) return false;
+
+    const int cx = centerX.load(std::memory_order_relaxed);
+    const int cy = centerY.load(std::memory_order_relaxed);
+    auto distance = [&](const std::pair<int, int>& c) {
+        return std::max(std::abs(c.first - cx), std::abs(c.second - cy));
+    };
+    auto closest = std::min_element(pending.begin(), pending.end(),
+        [&](const std::pair<int, int>& a, const std::pair<int, int>& b) { return distance(a) < distance(b); });
+
+    chunkX = closest->first;
+    chunkY = closest->second;
+    stale = distance(*closest) > keepRadius.load(std::memory_order_relaxed);
+    *closest = pending.back();
+    pending.pop_back();
+    return true;
+}
+
+void ChunkJobSystem::WorkerLoop(unsigned workerIndex) {
+    SpscQueue<ChunkJobResult>& output = *results[workerIndex];
+    ScratchArena scratch;
+
+    while (true) {
+        ChunkJobResult result;
+        bool stale = false;
+        {
+            std::unique_lock<std::mutex> lock(requestMutex);
+            requestReady.wait(lock, [&] { return stopping || !pending.empty(); });
+            if (stopping) return;
+            TakeClosestRequest(result.chunkX, result.chunkY, stale);
+            if (!stale && !spareChunks.empty()) {
+                result.chunk = std::move(spareChunks.back());
+                spareChunks.pop_back();
+            }
+        }
+
+        if (!stale) {
+            if (!result.chunk) {
+                result.chunk = std::make_unique<Chunk>();
+            }
+            result.chunk->chunkX = result.chunkX;
+            result.chunk->chunkY = result.chunkY;
+            GenerateChunk(config, noise, scratch, *result.chunk);
+        }
+
+        // Stale results are still published so the main thread can forget the request
+        while (!output.TryPush(std::move(result))) {
+            {
+                std::lock_guard<std::mutex> lock(requestMutex);
+                if (stopping) return;
+            }
+            std::this_thread::yield();
+        }
+    }
+}
@@ -0,0 +1,141 @@
+#include "ChunkManager.h"
+#include "World.h"
+#include "Telemetry.h"
+#include <algorithm>
+#include <cmath>
+
+ChunkManager::ChunkManager(size_t memoryBudgetBytes, int loadRadius, unsigned workerThreads,
+                           const WorldGenConfig& config)
+    : config(config), noise(CreateWorldNoise(config)), memoryBudget(memoryBudgetBytes), loadRadius(loadRadius) {
+    if (workerThreads > 0) {
+        jobs = std::make_unique<ChunkJobSystem>(this->config, noise, workerThreads);
+    }
+}
+
+void GenerateChunk(const WorldGenConfig& config, const NoiseGenerator& noise, ScratchArena& scratch, Chunk& chunk) {
+    if (chunk.tiles.Width() != CHUNK_SIZE || chunk.tiles.Height() != CHUNK_SIZE) {
+        chunk.tiles = WorldTiles(CHUNK_SIZE, CHUNK_SIZE);
+    }
+    GenerateRegion(config, noise, chunk.chunkX * CHUNK_SIZE, chunk.chunkY * CHUNK_SIZE, scratch, chunk.tiles);
+    scratch.Reset();
+}
+
+const Chunk* ChunkManager::FindChunk(int chunkX, int chunkY) const {
+    auto it = chunks.find(Key(chunkX, chunkY));
+    return it == chunks.end() ? nullptr : it->second.chunk.get();
+}
+
+TerrainBlock ChunkManager::BlockAt(int x, int y) const {
+    const int chunkX = TileToChunk(x);
+    const int chunkY = TileToChunk(y);
+    const Chunk* chunk = FindChunk(chunkX, chunkY);
+    return {chunk ? &chunk->tiles : nullptr, chunkX * CHUNK_SIZE, chunkY * CHUNK_SIZE, CHUNK_SIZE, CHUNK_SIZE};
+}
+
+void ChunkManager::Touch(Entry& entry) {
+    lru.splice(lru.begin(), lru, entry.lruPosition);
+}
+
+void ChunkManager::Insert(std::unique_ptr<Chunk> chunk) {
+    ElevationRange range = ComputeElevationRange(chunk->tiles);
+    if (!hasElevation) {
+        elevationRange = range;
+        hasElevation = true;
+    } else {
+        elevationRange.min = std::min(elevationRange.min, range.min);
+        elevationRange.max = std::max(elevationRange.max, range.max);
+    }
+
+    const uint64_t key = Key(chunk->chunkX, chunk->chunkY);
+    memoryUsed += chunk->tiles.MemoryBytes();
+    revision++;
+    lru.push_front(key);
+    chunks[key] = Entry{std::move(chunk), lru.begin()};
+}
+
+void ChunkManager::EvictOverBudget(int centerChunkX, int centerChunkY) {
+    auto it = lru.end();
+    while (memoryUsed > memoryBudget && it != lru.begin()) {
+        --it;
+        auto entry = chunks.find(*it);
+        const Chunk& chunk = *entry->second.chunk;
+        if (std::abs(chunk.chunkX - centerChunkX) <= loadRadius &&
+            std::abs(chunk.chunkY - centerChunkY) <= loadRadius) {
+            continue; // Still needed around the center
+        }
+        memoryUsed -= chunk.tiles.MemoryBytes();
+        revision++;
+        if (spareChunks.size() < CHUNK_SPARE_LIMIT) {
+            spareChunks.push_back(std::move(entry->second.chunk));
+        }
+        chunks.erase(entry);
+        it = lru.erase(it);
+    }
+}
+
+std::unique_ptr<Chunk> ChunkManager::TakeSpareChunk() {
+    if (spareChunks.empty()) {
+        return std::make_unique<Chunk>();
+    }
+    std::unique_ptr<Chunk> chunk = std::move(spareChunks.back());
+    spareChunks.pop_back();
+    return chunk;
+}
+
+void ChunkManager::Update(float centerX, float centerY) {
+    const int centerChunkX = TileToChunk(static_cast<int>(std::floor(centerX)));
+    const int centerChunkY = TileToChunk(static_cast<int>(std::floor(centerY)));
+
+    if (jobs) {
+        // Collect whatever the workers finished since the last call
+        ChunkJobResult result;
+        while (jobs->TryPopResult(result)) {
+            inFlight.erase(Key(result.chunkX, result.chunkY));
+            if (result.chunk && !FindChunk(result.chunkX, result.chunkY)) {
+                Insert(std::move(result.chunk));
+            }
+        }
+        // One chunk of slack so requests near the edge survive small back-and-forth moves
+        jobs->SetCenter(centerChunkX, centerChunkY, loadRadius + 1);
+    }
+
+    for (int cy = centerChunkY - loadRadius; cy <= centerChunkY + loadRadius; ++cy) {
+        for (int cx = centerChunkX - loadRadius; cx <= centerChunkX + loadRadius; ++cx) {
+            const uint64_t key = Key(cx, cy);
+            auto it = chunks.find(key);
+            if (it != chunks.end()) {
+                Touch(it->second);
+                continue;
+            }
+            if (jobs) {
+                if (inFlight.insert(key).second) {
+                    unsentRequests.emplace_back(cx, cy);
+                }
+                continue;
+            }
+            std::unique_ptr<Chunk> chunk = TakeSpareChunk();
+            chunk->chunkX = cx;
+            chunk->chunkY = cy;
+            GenerateChunk(config, noise, scratch, *chunk);
+            Insert(std::move(chunk));
+        }
+    }
+
+    if (jobs && jobs->TryRequest(unsentRequests)) {
+        unsentRequests.clear();
+    }
+
+    EvictOverBudget(centerChunkX, centerChunkY);
+
+    // Workers generate into evicted chunks; whatever they do not take stays here
+    if (jobs) {
+        jobs->TryRecycle(spareChunks);
+    }
+
+    static TelemetryGauge& residentGauge = RegisterGauge("chunks.resident");
+    static TelemetryGauge& pendingGauge = RegisterGauge("chunks.pending");
+    static TelemetryGauge& memoryGauge = RegisterGauge("chunks.memory_bytes");
+    residentGauge.Set(static_cast<double>(chunks.size()));
+    pendingGauge.Set(static_cast<double>(inFlight.size()));
+    memoryGauge.Set(static_cast<double>(memoryUsed));
+}
@@ -0,0 +1,194 @@
+#include "ChunkTextureCache.h"
+#include <algorithm> // For std::min, std::max
+#include <cmath>     // For std::floor
+
+static const int N = RENDER_CHUNK_SIZE;
+
+static int TileToBlock(int tile) {
+    return tile >= 0 ? tile / N : -((-tile + N - 1) / N);
+}
+
+static uint64_t BlockKey(int blockX, int blockY) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(blockX)) << 32) | static_cast<uint32_t>(blockY);
+}
+
+ChunkTextureCache::ChunkTextureCache(SDL_Renderer* renderer, size_t maxTextures)
+    : renderer(renderer), maxTextures(std::max<size_t>(maxTextures, 1)),
+      supported(SDL_RenderTargetSupported(renderer) == SDL_TRUE) {}
+
+ChunkTextureCache::~ChunkTextureCache() {
+    InvalidateAll();
+}
+
+void ChunkTextureCache::InvalidateAll() {
+    for (auto& item : entries) {
+        if (item.second.texture) SDL_DestroyTexture(item.second.texture);
+    }
+    entries.clear();
+}
+
+void ChunkTextureCache::Invalidate(int minX, int minY, int maxX, int maxY) {
+    for (int by = TileToBlock(minY); by <= TileToBlock(maxY); ++by) {
+        for (int bx = TileToBlock(minX); bx <= TileToBlock(maxX); ++bx) {
+            auto it = entries.find(BlockKey(bx, by));
+            if (it != entries.end()) it->second.dirty = true;
+        }
+    }
+}
+
+// Renders tiles [blockX * N, +N) x [blockY * N, +N) of block into the entry's texture.
+// Local tile (lx, ly) lands at ((lx - ly) * W/2, (lx + ly) * H/2 - elevation) from the
+// texture origin, which is exactly the tile's offset from block tile (0, 0) on screen.
+bool ChunkTextureCache::Bake(Entry& entry, const TerrainBlock& block, int blockX, int blockY) {
+    const WorldTiles& tiles = *block.tiles;
+    const int localX = blockX * N - block.originX;
+    const int localY = blockY * N - block.originY;
+
+    int minElevation = tiles.elevation(localX, localY);
+    int maxElevation = minElevation;
+    for (int ly = 0; ly < N; ++ly) {
+        const int16_t* elevationRow = tiles.elevation.Row(localY + ly) + localX;
+        for (int lx = 0; lx < N; ++lx) {
+            minElevation = std::min<int>(minElevation, elevationRow[lx]);
+            maxElevation = std::max<int>(maxElevation, elevationRow[lx]);
+        }
+    }
+
+    const int width = N * TILE_WIDTH;
+    const int height = N * TILE_HEIGHT + (maxElevation - minElevation);
+    if (!entry.texture || entry.width != width || entry.height != height) {
+        if (entry.texture) SDL_DestroyTexture(entry.texture);
+        entry.texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height);
+        if (!entry.texture) return false;
+        SDL_SetTextureBlendMode(entry.texture, SDL_BLENDMODE_BLEND);
+        entry.width = width;
+        entry.height = height;
+    }
+    entry.originX = N * TILE_WIDTH / 2;
+    entry.originY = maxElevation + TILE_HEIGHT / 2;
+
+    // Same row-by-row order as the per-tile path, so overlaps resolve the same way
+    bakeBatch.Clear();
+    for (int ly = 0; ly < N; ++ly) {
+        const int16_t* elevationRow = tiles.elevation.Row(localY + ly) + localX;
+        for (int lx = 0; lx < N; ++lx) {
+            bakeBatch.AddTile(entry.originX + (lx - ly) * (TILE_WIDTH / 2),
+                              entry.originY + (lx + ly) * (TILE_HEIGHT / 2) - elevationRow[lx],
+                              tiles.ColorAt(localX + lx, localY + ly, block.originX, block.originY));
+        }
+    }
+
+    SDL_Texture* previousTarget = SDL_GetRenderTarget(renderer);
+    SDL_SetRenderTarget(renderer, entry.texture);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    bakeBatch.Draw(renderer);
+    SDL_SetRenderTarget(renderer, previousTarget);
+
+    entry.source = block.tiles;
+    entry.dirty = false;
+    return true;
+}
+
+// Frees the least recently drawn textures over the limit, never one drawn this frame
+void ChunkTextureCache::EvictUnused() {
+    while (entries.size() > maxTextures) {
+        auto oldest = entries.end();
+        for (auto it = entries.begin(); it != entries.end(); ++it) {
+            if (it->second.lastDrawn < frame && (oldest == entries.end() || it->second.lastDrawn < oldest->second.lastDrawn)) {
+                oldest = it;
+            }
+        }
+        if (oldest == entries.end()) return;
+        if (oldest->second.texture) SDL_DestroyTexture(oldest->second.texture);
+        entries.erase(oldest);
+    }
+}
+
+ChunkTextureStats ChunkTextureCache::Draw(const TerrainSource& terrain, const VisibleTileRange& visible,
+                                          const Camera& camera, TileBatch& fallback) {
+    ChunkTextureStats stats;
+    ++frame;
+    if (visible.yEnd <= visible.yBegin) return stats;
+
+    for (int blockY = TileToBlock(visible.yBegin); blockY <= TileToBlock(visible.yEnd - 1); ++blockY) {
+        // Block columns touched by any visible row of this block row
+        const int rowBegin = std::max(blockY * N, visible.yBegin);
+        const int rowEnd = std::min(blockY * N + N, visible.yEnd);
+        int minX = 0, maxX = -1;
+        bool any = false;
+        for (int y = rowBegin; y < rowEnd; ++y) {
+            if (visible.RowEnd(y) <= visible.RowBegin(y)) continue;
+            minX = any ? std::min(minX, visible.RowBegin(y)) : visible.RowBegin(y);
+            maxX = any ? std::max(maxX, visible.RowEnd(y) - 1) : visible.RowEnd(y) - 1;
+            any = true;
+        }
+        if (!any) continue;
+
+        for (int blockX = TileToBlock(minX); blockX <= TileToBlock(maxX); ++blockX) {
+            const int tileX = blockX * N;
+            const int tileY = blockY * N;
+            const TerrainBlock block = terrain.BlockAt(tileX, tileY);
+            const bool bakeable = block.tiles && tileX >= block.originX && tileY >= block.originY &&
+                                  tileX + N <= block.originX + block.width &&
+                                  tileY + N <= block.originY + block.height;
+
+            Entry* entry = nullptr;
+            if (bakeable) {
+                // New entries start dirty; a different source means the chunk was regenerated.
+                // Regenerating into the same recycled storage yields the same tiles, so the
+                // texture stays valid then.
+                entry = &entries[BlockKey(blockX, blockY)];
+                if (entry->dirty || entry->source != block.tiles) {
+                    if (Bake(*entry, block, blockX, blockY)) {
+                        stats.texturesBaked++;
+                    } else {
+                        if (entry->texture) SDL_DestroyTexture(entry->texture);
+                        entries.erase(BlockKey(blockX, blockY));
+                        entry = nullptr;
+                    }
+                }
+            }
+
+            if (!entry) {
+                // Not resident (or partly outside the world): per-tile path for the visible part
+                fallbackRange.yBegin = rowBegin;
+                fallbackRange.yEnd = rowEnd;
+                fallbackRange.xBegin.resize(rowEnd - rowBegin);
+                fallbackRange.xEnd.resize(rowEnd - rowBegin);
+                for (int y = rowBegin; y < rowEnd; ++y) {
+                    fallbackRange.xBegin[y - rowBegin] = std::max(visible.RowBegin(y), tileX);
+                    fallbackRange.xEnd[y - rowBegin] = std::min(visible.RowEnd(y), tileX + N);
+                }
+                stats.fallbackTiles += BatchVisibleTiles(terrain, fallbackRange, camera, fallback);
+                continue;
+            }
+
+            // Screen position of the block's (0, 0) tile center at elevation 0, the same
+            // projection as WorldToScreen but floored so neighbouring blocks line up exactly.
+            // Other zooms scale the copy; at zoom 1 this is an exact pixel offset.
+            const float worldX = static_cast<float>(tileX);
+            const float worldY = static_cast<float>(tileY);
+            const float zoom = camera.zoom;
+            const float screenX = (worldX - worldY) * (TILE_WIDTH / 2.0f) * zoom - camera.x;
+            const float screenY = (worldX + worldY) * (TILE_HEIGHT / 2.0f) * zoom - camera.y;
+            const int left = static_cast<int>(std::floor(screenX - entry->originX * zoom));
+            const int top = static_cast<int>(std::floor(screenY - entry->originY * zoom));
+            const int right = static_cast<int>(std::floor(screenX + (entry->width - entry->originX) * zoom));
+            const int bottom = static_cast<int>(std::floor(screenY + (entry->height - entry->originY) * zoom));
+
+            SDL_Rect destination = {left, top, right - left, bottom - top};
+            entry->lastDrawn = frame;
+            if (destination.x + destination.w <= 0 || destination.x >= SCREEN_WIDTH ||
+                destination.y + destination.h <= 0 || destination.y >= SCREEN_HEIGHT) {
+                continue;
+            }
+            SDL_RenderCopy(renderer, entry->texture, nullptr, &destination);
+            stats.texturesDrawn++;
+            stats.tilesCovered += N * N;
+        }
+    }
+
+    EvictUnused();
+    return stats;
+}
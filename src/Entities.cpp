@@ -0,0 +1,166 @@
+#include "Entities.h"
+#include "TerrainQuery.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+
+// Entities per batch; the batch's scratch arrays live on the stack
+static const int kEntityBatch = 256;
+// Below this many entities a thread pool costs more than it saves
+static const size_t kParallelEntities = 1024;
+
+size_t EntityStore::Add(float newX, float newY, float newElevation, float newVelocityX, float newVelocityY, SDL_Color newColor) {
+    x.push_back(newX);
+    y.push_back(newY);
+    elevation.push_back(newElevation);
+    previousX.push_back(newX);
+    previousY.push_back(newY);
+    previousElevation.push_back(newElevation);
+    velocityX.push_back(newVelocityX);
+    velocityY.push_back(newVelocityY);
+    velocityZ.push_back(0.0f);
+    isJumping.push_back(0);
+    color.push_back(newColor);
+    return x.size() - 1;
+}
+
+void EntityStore::Clear() {
+    for (Column<float>* column : {&x, &y, &elevation, &previousX, &previousY, &previousElevation,
+                                  &velocityX, &velocityY, &velocityZ}) {
+        column->clear();
+    }
+    isJumping.clear();
+    color.clear();
+}
+
+void EntityStore::Jump(size_t index) {
+    if (isJumping[index]) return;
+    // Same launch speed as the player; see HandlePlayerMovement
+    velocityZ[index] = JUMP_FORCE * PHYSICS_REFERENCE_RATE;
+    isJumping[index] = 1;
+}
+
+bool EntityStore::AtRest() const {
+    for (size_t i = 0; i < Count(); ++i) {
+        if (velocityX[i] != 0.0f || velocityY[i] != 0.0f || isJumping[i]) return false;
+        // Still easing onto the terrain
+        if (x[i] != previousX[i] || y[i] != previousY[i] || elevation[i] != previousElevation[i]) return false;
+    }
+    return true;
+}
+
+// resident[i] is 1 when the tile under (xs[i], ys[i]) is loaded; the block lookup is reused
+// while positions stay inside it
+static void ResidentTiles(const TerrainSource& world, const float* xs, const float* ys, uint8_t* resident, int count) {
+    TerrainBlock block{nullptr, 0, 0, 0, 0};
+    for (int i = 0; i < count; ++i) {
+        const int tileX = static_cast<int>(std::floor(xs[i]));
+        const int tileY = static_cast<int>(std::floor(ys[i]));
+        if (tileX < block.originX || tileX >= block.originX + block.width ||
+            tileY < block.originY || tileY >= block.originY + block.height) {
+            block = world.BlockAt(tileX, tileY);
+        }
+        resident[i] = block.tiles ? 1 : 0;
+    }
+}
+
+// One batch of at most kEntityBatch entities starting at first. The steps mirror
+// HandlePlayerMovement: move, clamp to the world, undo blocked steps, follow the terrain
+// unless airborne, then gravity and landing.
+static void UpdateBatch(EntityStore& entities, size_t first, int count, float deltaTime, const TerrainSource& world) {
+    float* x = entities.x.data() + first;
+    float* y = entities.y.data() + first;
+    float* elevation = entities.elevation.data() + first;
+    float* previousX = entities.previousX.data() + first;
+    float* previousY = entities.previousY.data() + first;
+    float* previousElevation = entities.previousElevation.data() + first;
+    float* velocityX = entities.velocityX.data() + first;
+    float* velocityY = entities.velocityY.data() + first;
+    float* velocityZ = entities.velocityZ.data() + first;
+    uint8_t* isJumping = entities.isJumping.data() + first;
+
+    for (int i = 0; i < count; ++i) {
+        previousX[i] = x[i];
+        previousY[i] = y[i];
+        previousElevation[i] = elevation[i];
+        x[i] += velocityX[i] * deltaTime;
+        y[i] += velocityY[i] * deltaTime;
+    }
+
+    // Same margins as the player; moving out of bounds turns the entity back
+    const TileBounds bounds = world.Bounds();
+    if (bounds.bounded) {
+        const float minX = bounds.minX + 1.0f;
+        const float minY = bounds.minY + 1.0f;
+        const float maxX = static_cast<float>(bounds.maxX - 2);
+        const float maxY = static_cast<float>(bounds.maxY - 2);
+        for (int i = 0; i < count; ++i) {
+            const float clampedX = std::max(minX, std::min(x[i], maxX));
+            const float clampedY = std::max(minY, std::min(y[i], maxY));
+            velocityX[i] = clampedX > x[i] ? std::abs(velocityX[i]) : clampedX < x[i] ? -std::abs(velocityX[i]) : velocityX[i];
+            velocityY[i] = clampedY > y[i] ? std::abs(velocityY[i]) : clampedY < y[i] ? -std::abs(velocityY[i]) : velocityY[i];
+            x[i] = clampedX;
+            y[i] = clampedY;
+        }
+    }
+
+    // Entities over tiles that are not loaded yet keep their elevation, like the player
+    uint8_t resident[kEntityBatch];
+    ResidentTiles(world, x, y, resident, count);
+
+    uint8_t walkable[kEntityBatch];
+    if (ENFORCE_WALKABILITY) {
+        SegmentsWalkable(world, previousX, previousY, x, y, walkable, count);
+        for (int i = 0; i < count; ++i) {
+            const bool blocked = resident[i] && !walkable[i];
+            x[i] = blocked ? previousX[i] : x[i];
+            y[i] = blocked ? previousY[i] : y[i];
+            velocityX[i] = blocked ? -velocityX[i] : velocityX[i];
+            velocityY[i] = blocked ? -velocityY[i] : velocityY[i];
+        }
+    } else {
+        std::fill(walkable, walkable + kEntityBatch, uint8_t{1});
+    }
+
+    float heights[kEntityBatch];
+    HeightsAt(world, x, y, heights, static_cast<size_t>(count));
+
+    // 20% of the gap per reference tick, as an exponential decay so any deltaTime converges the same way
+    const float follow = 1.0f - std::pow(0.8f, deltaTime * PHYSICS_REFERENCE_RATE);
+    const float gravityStep = GRAVITY * PHYSICS_REFERENCE_RATE * PHYSICS_REFERENCE_RATE * deltaTime;
+    for (int i = 0; i < count; ++i) {
+        const bool airborne = isJumping[i] != 0;
+        const bool follows = !airborne && resident[i] && walkable[i];
+        float z = elevation[i] + (follows ? (heights[i] - elevation[i]) * follow : 0.0f);
+        float vz = airborne ? velocityZ[i] - gravityStep : velocityZ[i];
+        z = airborne ? z + vz * deltaTime : z;
+
+        // Missing tiles count as INITIAL_ELEVATION for landing, as HeightsAt returns them
+        const bool landed = airborne && z <= heights[i];
+        elevation[i] = landed ? heights[i] : z;
+        velocityZ[i] = landed ? 0.0f : vz;
+        isJumping[i] = landed ? 0 : isJumping[i];
+    }
+}
+
+static void UpdateRange(EntityStore& entities, size_t begin, size_t end, float deltaTime, const TerrainSource& world) {
+    for (size_t first = begin; first < end; first += kEntityBatch) {
+        const int count = static_cast<int>(std::min<size_t>(kEntityBatch, end - first));
+        UpdateBatch(entities, first, count, deltaTime, world);
+    }
+}
+
+void UpdateEntities(EntityStore& entities, float deltaTime, const TerrainSource& world, ThreadPool* pool) {
+    const size_t count = entities.Count();
+    if (!pool || pool->ThreadCount() == 1 || count < kParallelEntities) {
+        UpdateRange(entities, 0, count, deltaTime, world);
+        return;
+    }
+    // Bands of whole batches, so neighbouring bands never write the same cache line
+    const int batches = static_cast<int>((count + kEntityBatch - 1) / kEntityBatch);
+    pool->ParallelFor(0, batches, [&](int bandBegin, int bandEnd) {
+        const size_t begin = static_cast<size_t>(bandBegin) * kEntityBatch;
+        const size_t end = std::min(count, static_cast<size_t>(bandEnd) * kEntityBatch);
+        UpdateRange(entities, begin, end, deltaTime, world);
+    });
+}
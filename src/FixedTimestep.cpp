@@ -0,0 +1,30 @@
+#include "../include/FixedTimestep.h"
+
+FixedTimestep::FixedTimestep(double stepSeconds, int maxStepsPerFrame)
+    : step(stepSeconds), maxSteps(maxStepsPerFrame),
+      secondsPerTick(1.0 / static_cast<double>(SDL_GetPerformanceFrequency())),
+      lastCounter(SDL_GetPerformanceCounter()) {}
+
+void FixedTimestep::Resync() {
+    lastCounter = SDL_GetPerformanceCounter();
+}
+
+int FixedTimestep::Advance() {
+    const Uint64 now = SDL_GetPerformanceCounter();
+    const double seconds = static_cast<double>(now - lastCounter) * secondsPerTick;
+    lastCounter = now;
+    return AdvanceBy(seconds);
+}
+
+int FixedTimestep::AdvanceBy(double seconds) {
+    frameSeconds = seconds;
+    accumulator += frameSeconds;
+    int steps = static_cast<int>(accumulator / step);
+    if (steps > maxSteps) {
+        steps = maxSteps;
+        accumulator = 0.0;
+    } else {
+        accumulator -= steps * step;
+    }
+    return steps;
+}
@@ -0,0 +1,68 @@
+#include "FrameCache.h"
+#include "GameConstants.h" // For SCREEN_WIDTH, SCREEN_HEIGHT, TILE_WIDTH, FRAME_SKIP_TOLERANCE_PX
+#include <algorithm>       // For std::max
+#include <cmath>           // For std::abs
+
+// Screen-space distance, in pixels, between two world positions at the given zoom
+// (an upper bound of the isometric projection, which is all the comparison needs)
+static float ScreenDistance(float dx, float dy, float dElevation, float zoom) {
+    const float planar = (std::abs(dx) + std::abs(dy)) * (TILE_WIDTH / 2.0f);
+    return std::max(planar, std::abs(dElevation)) * zoom;
+}
+
+FrameChange CompareFrames(const FrameState& drawn, const FrameState& next) {
+    if (drawn.zoom != next.zoom || drawn.lodLevel != next.lodLevel ||
+        drawn.terrainRevision != next.terrainRevision || drawn.debugMode != next.debugMode ||
+        drawn.chunkTextures != next.chunkTextures) {
+        return FrameChange::Full;
+    }
+    if (std::abs(next.cameraX - drawn.cameraX) >= FRAME_SKIP_TOLERANCE_PX ||
+        std::abs(next.cameraY - drawn.cameraY) >= FRAME_SKIP_TOLERANCE_PX) {
+        return FrameChange::Full;
+    }
+    if (ScreenDistance(next.playerX - drawn.playerX, next.playerY - drawn.playerY,
+                       next.playerElevation - drawn.playerElevation, next.zoom) >= FRAME_SKIP_TOLERANCE_PX) {
+        return FrameChange::PlayerOnly;
+    }
+    return FrameChange::None;
+}
+
+TerrainFrameCache::TerrainFrameCache(SDL_Renderer* renderer)
+    : renderer(renderer), supported(SDL_RenderTargetSupported(renderer) == SDL_TRUE) {}
+
+TerrainFrameCache::~TerrainFrameCache() {
+    if (texture) SDL_DestroyTexture(texture);
+}
+
+bool TerrainFrameCache::BeginCapture(SDL_Color clearColor) {
+    valid = false;
+    if (!supported) return false;
+    if (!texture) {
+        texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                    SCREEN_WIDTH, SCREEN_HEIGHT);
+        if (!texture) {
+            supported = false; // Out of video memory or similar; keep drawing directly
+            return false;
+        }
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_NONE);
+    }
+    SDL_SetRenderTarget(renderer, texture);
+    SDL_SetRenderDrawColor(renderer, clearColor.r, clearColor.g, clearColor.b, clearColor.a);
+    SDL_RenderClear(renderer);
+    capturing = true;
+    return true;
+}
+
+void TerrainFrameCache::EndCapture() {
+    if (!capturing) return;
+    SDL_SetRenderTarget(renderer, nullptr);
+    capturing = false;
+    valid = true;
+    Draw();
+}
+
+bool TerrainFrameCache::Draw() {
+    if (!valid) return false;
+    SDL_RenderCopy(renderer, texture, nullptr, nullptr);
+    return true;
+}
@@ -0,0 +1,175 @@
+#include "InputReplay.h"
+#include <cstdio>   // For std::snprintf
+#include <cstdlib>  // For std::strtol, std::strtod
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+// SDL's name for a key with spaces swapped for underscores, so a line splits on whitespace.
+// Keys without a name that reads back to the same key are written as raw codes.
+static std::string ScancodeToken(SDL_Scancode scancode) {
+    std::string name = SDL_GetScancodeName(scancode);
+    for (char& c : name) {
+        if (c == ' ') c = '_';
+    }
+    if (name.empty() || name == "|" || SDL_GetScancodeFromName(SDL_GetScancodeName(scancode)) != scancode) {
+        char raw[16];
+        std::snprintf(raw, sizeof(raw), "0x%x", static_cast<unsigned>(scancode));
+        return raw;
+    }
+    return name;
+}
+
+static std::string KeycodeToken(SDL_Keycode key) {
+    std::string name = SDL_GetKeyName(key);
+    for (char& c : name) {
+        if (c == ' ') c = '_';
+    }
+    if (name.empty() || name == "|" || SDL_GetKeyFromName(SDL_GetKeyName(key)) != key) {
+        char raw[16];
+        std::snprintf(raw, sizeof(raw), "0x%x", static_cast<unsigned>(key));
+        return raw;
+    }
+    return name;
+}
+
+// Parses a 0x-prefixed hex code as written for keys without a usable name
+static bool ParseRawCode(const std::string& token, long& code) {
+    if (token.size() < 3 || token[0] != '0' || (token[1] != 'x' && token[1] != 'X')) return false;
+    char* end = nullptr;
+    code = std::strtol(token.c_str() + 2, &end, 16);
+    return *end == '\0';
+}
+
+// SDL key name of a token: underscores back to spaces
+static std::string TokenName(std::string token) {
+    for (char& c : token) {
+        if (c == '_') c = ' ';
+    }
+    return token;
+}
+
+static bool ParseScancode(const std::string& token, SDL_Scancode& scancode) {
+    long code = 0;
+    if (ParseRawCode(token, code)) {
+        if (code <= 0 || code >= SDL_NUM_SCANCODES) return false;
+        scancode = static_cast<SDL_Scancode>(code);
+        return true;
+    }
+    scancode = SDL_GetScancodeFromName(TokenName(token).c_str());
+    return scancode != SDL_SCANCODE_UNKNOWN;
+}
+
+static bool ParseKeycode(const std::string& token, SDL_Keycode& key) {
+    long code = 0;
+    if (ParseRawCode(token, code)) {
+        key = static_cast<SDL_Keycode>(code);
+        return code != SDLK_UNKNOWN;
+    }
+    key = SDL_GetKeyFromName(TokenName(token).c_str());
+    return key != SDLK_UNKNOWN;
+}
+
+static void WriteRun(std::ofstream& out, const InputFrame& frame, size_t count) {
+    char seconds[32];
+    std::snprintf(seconds, sizeof(seconds), "%.17g", frame.seconds); // Round-trips exactly
+    out << count << " " << seconds;
+    for (SDL_Scancode scancode : frame.held) out << " " << ScancodeToken(scancode);
+    if (!frame.pressed.empty()) {
+        out << " |";
+        for (SDL_Keycode key : frame.pressed) out << " " << KeycodeToken(key);
+    }
+    out << "\n";
+}
+
+bool InputRecording::Save(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Could not write input recording " << path << std::endl;
+        return false;
+    }
+    out << "# count seconds [held keys] [| pressed keys]\n";
+    // Standing still or holding the same keys at a steady frame rate collapses into one line
+    size_t first = 0;
+    for (size_t i = 1; i <= frames.size(); ++i) {
+        if (i == frames.size() || !(frames[i] == frames[first])) {
+            WriteRun(out, frames[first], i - first);
+            first = i;
+        }
+    }
+    if (!out) {
+        std::cerr << "Could not write input recording " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool InputRecording::Load(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "Could not open input recording " << path << std::endl;
+        return false;
+    }
+
+    std::vector<InputFrame> loaded;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line)) {
+        ++lineNumber;
+        std::istringstream fields(line);
+        std::string token;
+        if (!(fields >> token) || token[0] == '#') continue;
+
+        char* end = nullptr;
+        const long count = std::strtol(token.c_str(), &end, 10);
+        InputFrame frame;
+        std::string secondsToken;
+        if (*end != '\0' || count <= 0 || !(fields >> secondsToken)) {
+            std::cerr << path << ":" << lineNumber << ": expected <count> <seconds>" << std::endl;
+            return false;
+        }
+        frame.seconds = std::strtod(secondsToken.c_str(), &end);
+        if (*end != '\0' || !(frame.seconds >= 0.0)) {
+            std::cerr << path << ":" << lineNumber << ": invalid frame time " << secondsToken << std::endl;
+            return false;
+        }
+
+        bool pressedKeys = false;
+        while (fields >> token) {
+            if (token == "|" && !pressedKeys) {
+                pressedKeys = true;
+                continue;
+            }
+            bool valid;
+            if (pressedKeys) {
+                SDL_Keycode key;
+                valid = ParseKeycode(token, key);
+                if (valid) frame.pressed.push_back(key);
+            } else {
+                SDL_Scancode scancode;
+                valid = ParseScancode(token, scancode);
+                if (valid) frame.held.push_back(scancode);
+            }
+            if (!valid) {
+                std::cerr << path << ":" << lineNumber << ": unknown key " << token << std::endl;
+                return false;
+            }
+        }
+        loaded.insert(loaded.end(), static_cast<size_t>(count), frame);
+    }
+
+    frames.swap(loaded);
+    return true;
+}
+
+void CaptureHeldKeys(const Uint8* keyState, InputFrame& frame) {
+    frame.held.clear();
+    for (int scancode = 0; scancode < SDL_NUM_SCANCODES; ++scancode) {
+        if (keyState[scancode]) frame.held.push_back(static_cast<SDL_Scancode>(scancode));
+    }
+}
+
+void FillKeyState(const InputFrame& frame, std::vector<Uint8>& keyState) {
+    keyState.assign(SDL_NUM_SCANCODES, 0);
+    for (SDL_Scancode scancode : frame.held) keyState[scancode] = 1;
+}
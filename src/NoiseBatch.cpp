@@ -0,0 +1,288 @@
+#include "Noise.h"
+#include <algorithm> // For std::min
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define NOISE_HAS_AVX2_KERNEL 1
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define NOISE_HAS_NEON_KERNEL 1
+#endif
+
+// Batch kernels for NoiseGenerator::LayeredRow.
+// Each kernel mirrors the scalar PerlinNoise/Fade/Grad/Lerp operations one for one
+// (same operation order, no fused multiply-add), which is what keeps them bit-identical
+// to NoiseGenerator::Layered. Tables for seeds seed..seed+octaves-1 are contiguous in the
+// generator, so kernels receive the first table and step 512 entries per octave.
+
+#ifdef NOISE_HAS_AVX2_KERNEL
+namespace {
+
+__attribute__((target("avx2")))
+inline __m256 Fade8(__m256 t) {
+    __m256 t3 = _mm256_mul_ps(_mm256_mul_ps(t, t), t);
+    __m256 inner = _mm256_sub_ps(_mm256_mul_ps(t, _mm256_set1_ps(6.0f)), _mm256_set1_ps(15.0f));
+    inner = _mm256_add_ps(_mm256_mul_ps(t, inner), _mm256_set1_ps(10.0f));
+    return _mm256_mul_ps(t3, inner);
+}
+
+__attribute__((target("avx2")))
+inline __m256 Lerp8(__m256 a, __m256 b, __m256 t) {
+    return _mm256_add_ps(a, _mm256_mul_ps(t, _mm256_sub_ps(b, a)));
+}
+
+__attribute__((target("avx2")))
+inline __m256 Grad8(__m256i hash, __m256 x, __m256 y) {
+    __m256i h = _mm256_and_si256(hash, _mm256_set1_epi32(15));
+    // u = h < 8 ? x : y
+    __m256 hLt8 = _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(8), h));
+    __m256 u = _mm256_blendv_ps(y, x, hLt8);
+    // v = h < 4 ? y : (h == 12 || h == 14 ? x : 0)
+    __m256 hLt4 = _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(4), h));
+    __m256 h12or14 = _mm256_castsi256_ps(_mm256_or_si256(
+        _mm256_cmpeq_epi32(h, _mm256_set1_epi32(12)),
+        _mm256_cmpeq_epi32(h, _mm256_set1_epi32(14))));
+    __m256 v = _mm256_blendv_ps(_mm256_and_ps(h12or14, x), y, hLt4);
+    // Sign flips from bits 0 and 1, moved into the float sign bit
+    __m256 uSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(1)), 31));
+    __m256 vSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(2)), 30));
+    return _mm256_add_ps(_mm256_xor_ps(u, uSign), _mm256_xor_ps(v, vSign));
+}
+
+__attribute__((target("avx2")))
+void LayeredRowAVX2(const int* tables, const float* xs, float y, int count, int octaves,
+                    float persistence, float scale, float* out) {
+    const __m256i mask255 = _mm256_set1_epi32(255);
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256 onef = _mm256_set1_ps(1.0f);
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256 x = _mm256_loadu_ps(xs + i);
+        __m256 total = _mm256_setzero_ps();
+        float amplitude = 1.0f;
+        float frequency = scale;
+        float maxValue = 0.0f;
+
+        for (int o = 0; o < octaves; ++o) {
+            const int* p = tables + static_cast<size_t>(o) * 512;
+
+            // y is shared by the whole row, so its half of the lattice math stays scalar
+            float fy = y * frequency;
+            int Y = static_cast<int>(std::floor(fy)) & 255;
+            fy -= std::floor(fy);
+            const __m256 yf = _mm256_set1_ps(fy);
+            const __m256 yf1 = _mm256_set1_ps(fy - 1);
+            const __m256 v = _mm256_set1_ps(Fade(fy));
+            const __m256i Yv = _mm256_set1_epi32(Y);
+
+            __m256 fx = _mm256_mul_ps(x, _mm256_set1_ps(frequency));
+            __m256 floorX = _mm256_floor_ps(fx);
+            __m256i X = _mm256_and_si256(_mm256_cvttps_epi32(floorX), mask255);
+            fx = _mm256_sub_ps(fx, floorX);
+            __m256 fx1 = _mm256_sub_ps(fx, onef);
+            __m256 u = Fade8(fx);
+
+            __m256i A = _mm256_add_epi32(_mm256_i32gather_epi32(p, X, 4), Yv);
+            __m256i AA = _mm256_i32gather_epi32(p, A, 4);
+            __m256i AB = _mm256_i32gather_epi32(p, _mm256_add_epi32(A, one), 4);
+            __m256i B = _mm256_add_epi32(_mm256_i32gather_epi32(p, _mm256_add_epi32(X, one), 4), Yv);
+            __m256i BA = _mm256_i32gather_epi32(p, B, 4);
+            __m256i BB = _mm256_i32gather_epi32(p, _mm256_add_epi32(B, one), 4);
+
+            __m256 n = Lerp8(
+                Lerp8(Grad8(_mm256_i32gather_epi32(p, AA, 4), fx, yf),
+                      Grad8(_mm256_i32gather_epi32(p, BA, 4), fx1, yf), u),
+                Lerp8(Grad8(_mm256_i32gather_epi32(p, AB, 4), fx, yf1),
+                      Grad8(_mm256_i32gather_epi32(p, BB, 4), fx1, yf1), u),
+                v);
+
+            total = _mm256_add_ps(total, _mm256_mul_ps(n, _mm256_set1_ps(amplitude)));
+            maxValue += amplitude;
+            amplitude *= persistence;
+            frequency *= 2.0f;
+        }
+
+        if (maxValue > 0) {
+            _mm256_storeu_ps(out + i, _mm256_div_ps(total, _mm256_set1_ps(maxValue)));
+        } else {
+            _mm256_storeu_ps(out + i, _mm256_setzero_ps());
+        }
+    }
+}
+
+bool CpuHasAVX2() {
+    static const bool hasAVX2 = __builtin_cpu_supports("avx2");
+    return hasAVX2;
+}
+
+} // namespace
+#endif // NOISE_HAS_AVX2_KERNEL
+
+#ifdef NOISE_HAS_NEON_KERNEL
+namespace {
+
+inline float32x4_t Fade4(float32x4_t t) {
+    float32x4_t t3 = vmulq_f32(vmulq_f32(t, t), t);
+    float32x4_t inner = vsubq_f32(vmulq_f32(t, vdupq_n_f32(6.0f)), vdupq_n_f32(15.0f));
+    inner = vaddq_f32(vmulq_f32(t, inner), vdupq_n_f32(10.0f));
+    return vmulq_f32(t3, inner);
+}
+
+inline float32x4_t Lerp4(float32x4_t a, float32x4_t b, float32x4_t t) {
+    return vaddq_f32(a, vmulq_f32(t, vsubq_f32(b, a)));
+}
+
+inline float32x4_t Grad4(int32x4_t hash, float32x4_t x, float32x4_t y) {
+    int32x4_t h = vandq_s32(hash, vdupq_n_s32(15));
+    float32x4_t u = vbslq_f32(vcltq_s32(h, vdupq_n_s32(8)), x, y);
+    uint32x4_t h12or14 = vorrq_u32(vceqq_s32(h, vdupq_n_s32(12)), vceqq_s32(h, vdupq_n_s32(14)));
+    float32x4_t xOrZero = vreinterpretq_f32_u32(vandq_u32(h12or14, vreinterpretq_u32_f32(x)));
+    float32x4_t v = vbslq_f32(vcltq_s32(h, vdupq_n_s32(4)), y, xOrZero);
+    uint32x4_t uSign = vshlq_n_u32(vreinterpretq_u32_s32(vandq_s32(h, vdupq_n_s32(1))), 31);
+    uint32x4_t vSign = vshlq_n_u32(vreinterpretq_u32_s32(vandq_s32(h, vdupq_n_s32(2))), 30);
+    return vaddq_f32(vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(u), uSign)),
+                     vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(v), vSign)));
+}
+
+// NEON has no gather, so permutation lookups go through a small lane array
+inline int32x4_t Lookup4(const int* p, int32x4_t index) {
+    int lanes[4];
+    vst1q_s32(lanes, index);
+    int values[4] = {p[lanes[0]], p[lanes[1]], p[lanes[2]], p[lanes[3]]};
+    return vld1q_s32(values);
+}
+
+void LayeredRowNEON(const int* tables, const float* xs, float y, int count, int octaves,
+                    float persistence, float scale, float* out) {
+    const int32x4_t mask255 = vdupq_n_s32(255);
+    const int32x4_t one = vdupq_n_s32(1);
+    const float32x4_t onef = vdupq_n_f32(1.0f);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const float32x4_t x = vld1q_f32(xs + i);
+        float32x4_t total = vdupq_n_f32(0.0f);
+        float amplitude = 1.0f;
+        float frequency = scale;
+        float maxValue = 0.0f;
+
+        for (int o = 0; o < octaves; ++o) {
+            const int* p = tables + static_cast<size_t>(o) * 512;
+
+            float fy = y * frequency;
+            int Y = static_cast<int>(std::floor(fy)) & 255;
+            fy -= std::floor(fy);
+            const float32x4_t yf = vdupq_n_f32(fy);
+            const float32x4_t yf1 = vdupq_n_f32(fy - 1);
+            const float32x4_t v = vdupq_n_f32(Fade(fy));
+            const int32x4_t Yv = vdupq_n_s32(Y);
+
+            float32x4_t fx = vmulq_f32(x, vdupq_n_f32(frequency));
+            float32x4_t floorX = vrndmq_f32(fx);
+            int32x4_t X = vandq_s32(vcvtq_s32_f32(floorX), mask255);
+            fx = vsubq_f32(fx, floorX);
+            float32x4_t fx1 = vsubq_f32(fx, onef);
+            float32x4_t u = Fade4(fx);
+
+            int32x4_t A = vaddq_s32(Lookup4(p, X), Yv);
+            int32x4_t AA = Lookup4(p, A);
+            int32x4_t AB = Lookup4(p, vaddq_s32(A, one));
+            int32x4_t B = vaddq_s32(Lookup4(p, vaddq_s32(X, one)), Yv);
+            int32x4_t BA = Lookup4(p, B);
+            int32x4_t BB = Lookup4(p, vaddq_s32(B, one));
+
+            float32x4_t n = Lerp4(
+                Lerp4(Grad4(Lookup4(p, AA), fx, yf), Grad4(Lookup4(p, BA), fx1, yf), u),
+                Lerp4(Grad4(Lookup4(p, AB), fx, yf1), Grad4(Lookup4(p, BB), fx1, yf1), u),
+                v);
+
+            total = vaddq_f32(total, vmulq_f32(n, vdupq_n_f32(amplitude)));
+            maxValue += amplitude;
+            amplitude *= persistence;
+            frequency *= 2.0f;
+        }
+
+        if (maxValue > 0) {
+            vst1q_f32(out + i, vdivq_f32(total, vdupq_n_f32(maxValue)));
+        } else {
+            vst1q_f32(out + i, vdupq_n_f32(0.0f));
+        }
+    }
+}
+
+} // namespace
+#endif // NOISE_HAS_NEON_KERNEL
+
+NoiseKernel ActiveNoiseKernel() {
+#ifdef NOISE_HAS_AVX2_KERNEL
+    if (CpuHasAVX2()) return NoiseKernel::AVX2;
+#endif
+#ifdef NOISE_HAS_NEON_KERNEL
+    return NoiseKernel::NEON;
+#endif
+    return NoiseKernel::Scalar;
+}
+
+const char* NoiseKernelName(NoiseKernel kernel) {
+    switch (kernel) {
+        case NoiseKernel::Auto:   return "auto";
+        case NoiseKernel::Scalar: return "scalar";
+        case NoiseKernel::AVX2:   return "avx2";
+        case NoiseKernel::NEON:   return "neon";
+    }
+    return "unknown";
+}
+
+void NoiseGenerator::LayeredRow(const float* xs, float y, int count, int octaves, float persistence,
+                                float scale, int seed, float* out, NoiseKernel kernel) const {
+    if (kernel == NoiseKernel::Auto) kernel = ActiveNoiseKernel();
+
+    // Vector kernels read the prebuilt tables directly; seeds outside the generator's
+    // range go through the scalar path, which knows how to fall back.
+    if (octaves > 0 && !(HasSeed(seed) && HasSeed(seed + octaves - 1))) {
+        kernel = NoiseKernel::Scalar;
+    }
+
+    int done = 0;
+    switch (kernel) {
+#ifdef NOISE_HAS_AVX2_KERNEL
+        case NoiseKernel::AVX2:
+            if (CpuHasAVX2()) {
+                LayeredRowAVX2(Table(seed), xs, y, count, octaves, persistence, scale, out);
+                done = count - count % 8;
+            }
+            break;
+#endif
+#ifdef NOISE_HAS_NEON_KERNEL
+        case NoiseKernel::NEON:
+            LayeredRowNEON(Table(seed), xs, y, count, octaves, persistence, scale, out);
+            done = count - count % 4;
+            break;
+#endif
+        default:
+            break;
+    }
+
+    // Scalar fallback and the tail that does not fill a full vector
+    for (int i = done; i < count; ++i) {
+        out[i] = Layered(xs[i], y, octaves, persistence, scale, seed);
+    }
+}
+
+void NoiseGenerator::LayeredRow(float x0, float dx, float y, int count, int octaves, float persistence,
+                                float scale, int seed, float* out, NoiseKernel kernel) const {
+    // Coordinates go through a stack buffer a chunk at a time, so rows of any length allocate
+    // nothing; the chunk is a whole number of vectors for every kernel
+    const int kChunk = 256;
+    float xs[kChunk];
+    for (int first = 0; first < count; first += kChunk) {
+        const int chunk = std::min(kChunk, count - first);
+        for (int i = 0; i < chunk; ++i) {
+            xs[i] = x0 + (first + i) * dx;
+        }
+        LayeredRow(xs, y, chunk, octaves, persistence, scale, seed, out + first, kernel);
+    }
+}
@@ -1,10 +1,11 @@
 #include "../include/Player.h"
+#include "../include/TerrainQuery.h"
 #include <iostream> // For std::cout (debug messages)
 #include <cmath>    // For std::abs, std::max, std::min
 #include <algorithm>// For std::max, std::min (redundant if cmath is included, but common practice)
 
 // Player movement logic
-void HandlePlayerMovement(Player& player, const Uint8* keystate, float deltaTime, const std::vector<std::vector<Tile>>& world) {
+void HandlePlayerMovement(Player& player, const Uint8* keystate, float deltaTime, const TerrainSource& world) {
     // Increase speed for better response
     float moveSpeed = PLAYER_SPEED * deltaTime * 5.0f;
 
@@ -44,53 +45,55 @@ void HandlePlayerMovement(Player& player, const Uint8* keystate, float deltaTime
 
     // Keep player within world bounds with some margin
     // Using 1.0f as margin, can be adjusted or made a constant
-    player.x = std::max(1.0f, std::min(player.x, static_cast<float>(WORLD_WIDTH - 2)));
-    player.y = std::max(1.0f, std::min(player.y, static_cast<float>(WORLD_HEIGHT - 2)));
+    // Streamed worlds have no bounds, so there is nothing to clamp against
+    const TileBounds bounds = world.Bounds();
+    if (bounds.bounded) {
+        player.x = std::max(bounds.minX + 1.0f, std::min(player.x, static_cast<float>(bounds.maxX - 2)));
+        player.y = std::max(bounds.minY + 1.0f, std::min(player.y, static_cast<float>(bounds.maxY - 2)));
+    }
 
     // Check if new position is walkable and adjust elevation
-    int tileX = static_cast<int>(player.x);
-    int tileY = static_cast<int>(player.y);
-
-    if (tileX >= 0 && tileX < WORLD_WIDTH && tileY >= 0 && tileY < WORLD_HEIGHT) {
-        const Tile& currentTile = world[tileY][tileX];
+    // floor rather than truncation so negative coordinates in streamed worlds map correctly
+    int tileX = static_cast<int>(std::floor(player.x));
+    int tileY = static_cast<int>(std::floor(player.y));
 
-        // Original code had 'false && !currentTile.walkable' effectively disabling walkability check
-        // Keeping that logic for now, meaning player can walk anywhere.
-        // TODO: Implement proper walkability check based on currentTile.walkable
-        if (false && !currentTile.walkable) {
+    // Tiles in chunks that are not loaded yet leave the player's elevation alone
+    if (world.HasTile(tileX, tileY)) {
+        // The swept test checks every tile crossed this step, so fast movement cannot skip
+        // a thin blocker. Off by default: the original code never enforced walkability and
+        // most of the generated world is water.
+        if (ENFORCE_WALKABILITY && !SegmentWalkable(world, prevX, prevY, player.x, player.y)) {
             player.x = prevX;
             player.y = prevY;
             // std::cout << "Blocked by non-walkable tile" << std::endl;
         } else {
             // Adjust player elevation to match the terrain
             if (!player.isJumping) {
-                float targetElevation = static_cast<float>(currentTile.elevation);
-                // Smoothly interpolate to terrain height
-                player.elevation += (targetElevation - player.elevation) * 0.2f;
+                float targetElevation = HeightAt(world, player.x, player.y);
+                // Smoothly interpolate to terrain height: 20% of the gap per reference tick,
+                // applied as an exponential decay so any deltaTime converges the same way
+                float follow = 1.0f - std::pow(0.8f, deltaTime * PHYSICS_REFERENCE_RATE);
+                player.elevation += (targetElevation - player.elevation) * follow;
             }
         }
     }
 
     // Handle jumping
+    // velocityZ is in elevation per second; JUMP_FORCE and GRAVITY are per reference tick
     if (keystate[SDL_SCANCODE_SPACE] && !player.isJumping) {
-        player.velocityZ = JUMP_FORCE;
+        player.velocityZ = JUMP_FORCE * PHYSICS_REFERENCE_RATE;
         player.isJumping = true;
         // std::cout << "Jumping!" << std::endl;
     }
 
     // Apply gravity and update elevation if jumping
     if (player.isJumping) {
-        player.velocityZ -= GRAVITY;
-        player.elevation += player.velocityZ;
+        player.velocityZ -= GRAVITY * PHYSICS_REFERENCE_RATE * PHYSICS_REFERENCE_RATE * deltaTime;
+        player.elevation += player.velocityZ * deltaTime;
 
         // Determine terrain height at current player (x,y) for landing detection
-        int currentTileX = static_cast<int>(player.x);
-        int currentTileY = static_cast<int>(player.y);
-        float terrainHeight = INITIAL_ELEVATION; // Default if out of bounds
-
-        if (currentTileX >= 0 && currentTileX < WORLD_WIDTH && currentTileY >= 0 && currentTileY < WORLD_HEIGHT) {
-            terrainHeight = static_cast<float>(world[currentTileY][currentTileX].elevation);
-        }
+        // Missing tiles count as INITIAL_ELEVATION
+        float terrainHeight = HeightAt(world, player.x, player.y);
 
         // Check for landing
         if (player.elevation <= terrainHeight) {
@@ -110,3 +113,11 @@ void HandlePlayerMovement(Player& player, const Uint8* keystate, float deltaTime
         lastPrintZ = player.elevation;
     }
 }
+
+Player InterpolatePlayer(const Player& previous, const Player& current, float alpha) {
+    Player blended = current;
+    blended.x = previous.x + (current.x - previous.x) * alpha;
+    blended.y = previous.y + (current.y - previous.y) * alpha;
+    blended.elevation = previous.elevation + (current.elevation - previous.elevation) * alpha;
+    return blended;
+}
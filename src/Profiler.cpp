@@ -0,0 +1,222 @@
+#include "Profiler.h"
+#include <algorithm> // For std::min, std::max, std::sort
+#include <cmath>     // For std::ceil
+#include <fstream>   // For DumpCsv
+
+static const int kPhaseCount = static_cast<int>(ProfilePhase::Count);
+
+// Overlay layout
+static const int kColumnWidth = 2;          // Pixels per frame in the graph
+static const int kGraphHeight = 120;
+static const float kGraphPixelsPerMs = 3.0f; // 40 ms fills the graph
+static const float kBarPixelsPerMs = 40.0f;  // Per-phase bars, averaged over the history
+static const float kBarPixelsPerTile = 0.25f;
+static const int kBarHeight = 8;
+
+static const SDL_Color kPhaseColors[kPhaseCount] = {
+    {230, 230, 80, 255},  // Events
+    {80, 200, 80, 255},   // Movement
+    {80, 200, 200, 255},  // Camera
+    {80, 120, 255, 255},  // Culling
+    {255, 140, 40, 255},  // Submission
+    {220, 80, 220, 255},  // Player
+    {160, 160, 160, 255}, // Overlay
+    {255, 60, 60, 255},   // Present
+};
+
+const char* ProfilePhaseName(ProfilePhase phase) {
+    switch (phase) {
+        case ProfilePhase::Events:     return "events";
+        case ProfilePhase::Movement:   return "movement";
+        case ProfilePhase::Camera:     return "camera";
+        case ProfilePhase::Culling:    return "culling";
+        case ProfilePhase::Submission: return "submission";
+        case ProfilePhase::Player:     return "player";
+        case ProfilePhase::Overlay:    return "overlay";
+        case ProfilePhase::Present:    return "present";
+        default:                       return "unknown";
+    }
+}
+
+FrameProfiler::FrameProfiler(int historyFrames) : frames(std::max(historyFrames, 1)) {}
+
+double FrameProfiler::TicksToMs(Uint64 ticks) {
+    static const double msPerTick = 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+    return static_cast<double>(ticks) * msPerTick;
+}
+
+void FrameProfiler::BeginFrame() {
+    current = FrameSample();
+    frameStart = SDL_GetPerformanceCounter();
+}
+
+void FrameProfiler::AddPhaseTime(ProfilePhase phase, double ms) {
+    current.phaseMs[static_cast<int>(phase)] += ms;
+}
+
+void FrameProfiler::SetTileCounts(int visited, int drawn) {
+    current.tilesVisited = visited;
+    current.tilesDrawn = drawn;
+}
+
+void FrameProfiler::EndFrame() {
+    current.frameMs = TicksToMs(SDL_GetPerformanceCounter() - frameStart);
+    frames[next] = current;
+    next = (next + 1) % static_cast<int>(frames.size());
+    count = std::min(count + 1, static_cast<int>(frames.size()));
+}
+
+const FrameSample& FrameProfiler::Frame(int age) const {
+    const int size = static_cast<int>(frames.size());
+    return frames[((next - 1 - age) % size + size) % size];
+}
+
+FrameSample FrameProfiler::Average() const {
+    FrameSample average;
+    if (count == 0) return average;
+
+    double visited = 0.0, drawn = 0.0;
+    for (int age = 0; age < count; ++age) {
+        const FrameSample& frame = Frame(age);
+        for (int p = 0; p < kPhaseCount; ++p) average.phaseMs[p] += frame.phaseMs[p];
+        average.frameMs += frame.frameMs;
+        visited += frame.tilesVisited;
+        drawn += frame.tilesDrawn;
+    }
+    for (int p = 0; p < kPhaseCount; ++p) average.phaseMs[p] /= count;
+    average.frameMs /= count;
+    average.tilesVisited = static_cast<int>(visited / count);
+    average.tilesDrawn = static_cast<int>(drawn / count);
+    return average;
+}
+
+bool FrameProfiler::DumpCsv(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) return false;
+
+    out << "frame,frame_ms";
+    for (int p = 0; p < kPhaseCount; ++p) out << "," << ProfilePhaseName(static_cast<ProfilePhase>(p)) << "_ms";
+    out << ",tiles_visited,tiles_drawn\n";
+
+    for (int age = count - 1; age >= 0; --age) {
+        const FrameSample& frame = Frame(age);
+        out << (count - 1 - age) << "," << frame.frameMs;
+        for (int p = 0; p < kPhaseCount; ++p) out << "," << frame.phaseMs[p];
+        out << "," << frame.tilesVisited << "," << frame.tilesDrawn << "\n";
+    }
+    return static_cast<bool>(out);
+}
+
+TimingPercentiles ComputePercentiles(std::vector<double> values) {
+    TimingPercentiles result;
+    if (values.empty()) return result;
+
+    std::sort(values.begin(), values.end());
+    const size_t count = values.size();
+    // Smallest value with at least the given fraction of values at or below it
+    auto rank = [&](double fraction) {
+        const size_t index = static_cast<size_t>(std::ceil(fraction * static_cast<double>(count)));
+        return values[std::max<size_t>(index, 1) - 1];
+    };
+    double sum = 0.0;
+    for (double value : values) sum += value;
+    result.mean = sum / static_cast<double>(count);
+    result.p50 = rank(0.50);
+    result.p95 = rank(0.95);
+    result.p99 = rank(0.99);
+    result.max = values.back();
+    return result;
+}
+
+static void WritePercentiles(std::ostream& out, const TimingPercentiles& timing) {
+    out << "{\"mean\": " << timing.mean << ", \"p50\": " << timing.p50 << ", \"p95\": " << timing.p95
+        << ", \"p99\": " << timing.p99 << ", \"max\": " << timing.max << "}";
+}
+
+void WriteFrameReport(const std::vector<FrameSample>& frames, std::ostream& out) {
+    std::vector<double> values;
+    values.reserve(frames.size());
+    double visited = 0.0, drawn = 0.0;
+    for (const FrameSample& frame : frames) {
+        values.push_back(frame.frameMs);
+        visited += frame.tilesVisited;
+        drawn += frame.tilesDrawn;
+    }
+    const double frameCount = std::max<double>(1.0, static_cast<double>(frames.size()));
+
+    out << "{\n";
+    out << "  \"frames\": " << frames.size() << ",\n";
+    out << "  \"frame_ms\": ";
+    WritePercentiles(out, ComputePercentiles(values));
+    out << ",\n  \"phase_ms\": {";
+    for (int p = 0; p < kPhaseCount; ++p) {
+        values.clear();
+        for (const FrameSample& frame : frames) values.push_back(frame.phaseMs[p]);
+        out << (p == 0 ? "\n" : ",\n") << "    \"" << ProfilePhaseName(static_cast<ProfilePhase>(p)) << "\": ";
+        WritePercentiles(out, ComputePercentiles(values));
+    }
+    out << "\n  },\n";
+    out << "  \"mean_tiles_visited\": " << visited / frameCount << ",\n";
+    out << "  \"mean_tiles_drawn\": " << drawn / frameCount << "\n";
+    out << "}" << std::endl;
+}
+
+void FrameProfiler::Draw(SDL_Renderer* renderer, int x, int y) const {
+    const int graphWidth = static_cast<int>(frames.size()) * kColumnWidth;
+    const int barsHeight = (kPhaseCount + 2) * (kBarHeight + 2) + 4;
+
+    SDL_Rect panel = {x, y, graphWidth, kGraphHeight + barsHeight};
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 200);
+    SDL_RenderFillRect(renderer, &panel);
+    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+    SDL_RenderDrawRect(renderer, &panel);
+
+    // One column per frame, newest on the right: phases stacked from the bottom in loop
+    // order, and whatever the phases don't cover in grey on top
+    const int baseline = y + kGraphHeight;
+    for (int age = 0; age < count; ++age) {
+        const FrameSample& frame = Frame(age);
+        const int columnX = x + graphWidth - (age + 1) * kColumnWidth;
+        int top = baseline;
+        double covered = 0.0;
+        for (int p = 0; p < kPhaseCount; ++p) {
+            covered += frame.phaseMs[p];
+            int segmentTop = std::max(y, baseline - static_cast<int>(covered * kGraphPixelsPerMs));
+            if (segmentTop < top) {
+                const SDL_Color& c = kPhaseColors[p];
+                SDL_Rect segment = {columnX, segmentTop, kColumnWidth, top - segmentTop};
+                SDL_SetRenderDrawColor(renderer, c.r, c.g, c.b, 255);
+                SDL_RenderFillRect(renderer, &segment);
+                top = segmentTop;
+            }
+        }
+        int frameTop = std::max(y, baseline - static_cast<int>(frame.frameMs * kGraphPixelsPerMs));
+        if (frameTop < top) {
+            SDL_Rect rest = {columnX, frameTop, kColumnWidth, top - frameTop};
+            SDL_SetRenderDrawColor(renderer, 90, 90, 90, 255);
+            SDL_RenderFillRect(renderer, &rest);
+        }
+    }
+
+    // 60 and 30 fps budget lines
+    SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255);
+    int line60 = baseline - static_cast<int>(1000.0f / 60.0f * kGraphPixelsPerMs);
+    SDL_RenderDrawLine(renderer, x, line60, x + graphWidth - 1, line60);
+    SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
+    int line30 = baseline - static_cast<int>(1000.0f / 30.0f * kGraphPixelsPerMs);
+    SDL_RenderDrawLine(renderer, x, line30, x + graphWidth - 1, line30);
+
+    // Average time of each phase, then tiles visited and drawn
+    const FrameSample average = Average();
+    auto drawBar = [&](int row, float length, SDL_Color color) {
+        SDL_Rect bar = {x + 4, baseline + 4 + row * (kBarHeight + 2),
+                        std::min(static_cast<int>(length), graphWidth - 8), kBarHeight};
+        SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, 255);
+        SDL_RenderFillRect(renderer, &bar);
+    };
+    for (int p = 0; p < kPhaseCount; ++p) {
+        drawBar(p, static_cast<float>(average.phaseMs[p]) * kBarPixelsPerMs, kPhaseColors[p]);
+    }
+    drawBar(kPhaseCount, average.tilesVisited * kBarPixelsPerTile, {200, 200, 200, 255});
+    drawBar(kPhaseCount + 1, average.tilesDrawn * kBarPixelsPerTile, {255, 255, 255, 255});
+}
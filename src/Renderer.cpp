@@ -1,104 +1,235 @@
 #include "Renderer.h"
-#include <cmath>      // For std::abs (though not used in current RenderTile, good for graphics)
+#include "Biomes.h"     // For TileColor
+#include <algorithm>  // For std::min, std::sort
+#include <cmath>      // For std::floor
 #include <iostream>   // For debug output (e.g. in RenderTile, can be removed)
 
 // Converts world coordinates to screen coordinates
-void WorldToScreen(float worldX, float worldY, float elevation, int& screenX, int& screenY, const Camera& camera, const Player& player) {
-    // Player is always at center, so calculate positions relative to the player
-    // Convert isometric coordinates relative to player's position
-    float relativeX = worldX - player.x;
-    float relativeY = worldY - player.y;
-    float relativeElevation = elevation - player.elevation;
-
-    // Convert to screen coordinates
-    screenX = static_cast<int>((relativeX - relativeY) * (TILE_WIDTH / 2.0f)); // Use floating point division
-    screenY = static_cast<int>((relativeX + relativeY) * (TILE_HEIGHT / 2.0f) - relativeElevation); // Use floating point division
-
-    // Add screen center offset to place player at center
-    screenX += SCREEN_WIDTH / 2;
-    screenY += SCREEN_HEIGHT / 2;
+void WorldToScreen(float worldX, float worldY, float elevation, int& screenX, int& screenY, const Camera& camera) {
+    // Isometric projection scaled by the zoom, then the camera offset, which already holds the screen center
+    screenX = static_cast<int>((worldX - worldY) * (TILE_WIDTH / 2.0f) * camera.zoom - camera.x); // Use floating point division
+    screenY = static_cast<int>(((worldX + worldY) * (TILE_HEIGHT / 2.0f) - elevation) * camera.zoom - camera.y); // Use floating point division
 }
 
-// Renders a single tile
-void RenderTile(SDL_Renderer* renderer, const Tile& tile, const Camera& camera, const Player& player) {
-    int screenX, screenY;
-    WorldToScreen(tile.x, tile.y, tile.elevation, screenX, screenY, camera, player);
-
-    // Calculate tile corners in screen space
-    SDL_Point points[5] = {
-        {screenX, screenY - (TILE_HEIGHT / 2)},                    // Top
-        {screenX + (TILE_WIDTH / 2), screenY},                     // Right
-        {screenX, screenY + (TILE_HEIGHT / 2)},                    // Bottom
-        {screenX - (TILE_WIDTH / 2), screenY},                     // Left
-        {screenX, screenY - (TILE_HEIGHT / 2)}                     // Back to top
+void RowProjection::Project(const int16_t* elevation, int count, int* screenX, int* screenY) const {
+    for (int i = 0; i < count; ++i) {
+        screenX[i] = static_cast<int>(originX + i * stepX);
+        screenY[i] = static_cast<int>(originY + i * stepY - elevation[i] * elevationScale);
+    }
+}
+
+RowProjector::RowProjector(const Camera& camera)
+    : halfW(TILE_WIDTH / 2.0f * camera.zoom), halfH(TILE_HEIGHT / 2.0f * camera.zoom),
+      zoom(camera.zoom), cameraX(camera.x), cameraY(camera.y) {}
+
+RowProjection RowProjector::Row(int y, int firstX) const {
+    RowProjection row;
+    // The first tile goes through the same terms as WorldToScreen
+    row.originX = (firstX - y) * halfW - cameraX;
+    row.originY = (firstX + y) * halfH - cameraY;
+    row.stepX = halfW;
+    row.stepY = halfH;
+    row.elevationScale = zoom;
+    return row;
+}
+
+// Outline shade used for tile borders: 40 levels darker for bright channels, lighter otherwise
+static SDL_Color OutlineColor(SDL_Color color) {
+    return {
+        static_cast<Uint8>(color.r > 128 ? color.r - 40 : color.r + 40),
+        static_cast<Uint8>(color.g > 128 ? color.g - 40 : color.g + 40),
+        static_cast<Uint8>(color.b > 128 ? color.b - 40 : color.b + 40),
+        255
     };
+}
+
+// Same margin test the render loop uses before submitting a tile, for tiles drawn at scale
+static bool IsTileOnScreen(int screenX, int screenY, float scale) {
+    const float marginX = TILE_WIDTH * scale;
+    const float marginY = TILE_HEIGHT * scale;
+    return screenX + marginX > 0 && screenX - marginX < SCREEN_WIDTH &&
+           screenY + marginY > 0 && screenY - marginY < SCREEN_HEIGHT;
+}
+
+void TileBatch::Clear() {
+    vertices.clear();
+    indices.clear();
+}
+
+void TileBatch::AddTile(int screenX, int screenY, SDL_Color color, float scale) {
+    const float cx = static_cast<float>(screenX);
+    const float cy = static_cast<float>(screenY);
+    const float halfW = TILE_WIDTH / 2.0f * scale;
+    const float halfH = TILE_HEIGHT / 2.0f * scale;
+    const SDL_Color outline = OutlineColor(color);
+    const int base = static_cast<int>(vertices.size());
+
+    // Outline diamond: Top, Right, Bottom, Left
+    vertices.push_back({{cx, cy - halfH}, outline, {0, 0}});
+    vertices.push_back({{cx + halfW, cy}, outline, {0, 0}});
+    vertices.push_back({{cx, cy + halfH}, outline, {0, 0}});
+    vertices.push_back({{cx - halfW, cy}, outline, {0, 0}});
+
+    // Fill diamond, inset by one pixel along the 2:1 edges so the outline stays visible
+    vertices.push_back({{cx, cy - halfH + 1.0f}, color, {0, 0}});
+    vertices.push_back({{cx + halfW - 2.0f, cy}, color, {0, 0}});
+    vertices.push_back({{cx, cy + halfH - 1.0f}, color, {0, 0}});
+    vertices.push_back({{cx - halfW + 2.0f, cy}, color, {0, 0}});
+
+    // Two triangles per diamond: (Top, Right, Bottom) and (Top, Bottom, Left)
+    for (int diamond = 0; diamond < 2; ++diamond) {
+        int d = base + diamond * 4;
+        indices.insert(indices.end(), {d, d + 1, d + 2, d, d + 2, d + 3});
+    }
+}
+
+bool TileBatch::AddTile(const Tile& tile, const Camera& camera) {
+    int screenX, screenY;
+    WorldToScreen(tile.x, tile.y, tile.elevation, screenX, screenY, camera);
+    if (!IsTileOnScreen(screenX, screenY, camera.zoom)) {
+        return false;
+    }
+    AddTile(screenX, screenY, tile.color, camera.zoom);
+    return true;
+}
+
+void TileBatch::Draw(SDL_Renderer* renderer) const {
+    if (indices.empty()) return;
+    SDL_RenderGeometry(renderer, nullptr,
+                       vertices.data(), static_cast<int>(vertices.size()),
+                       indices.data(), static_cast<int>(indices.size()));
+}
+
+int EntityBatch::Build(const EntityStore& entities, float alpha, const Camera& camera) {
+    sprites.clear();
+    vertices.clear();
+    indices.clear();
+
+    const float halfW = TILE_WIDTH / 2.0f * camera.zoom;
+    const float halfH = TILE_HEIGHT / 2.0f * camera.zoom;
+    for (size_t i = 0; i < entities.Count(); ++i) {
+        const float x = entities.previousX[i] + (entities.x[i] - entities.previousX[i]) * alpha;
+        const float y = entities.previousY[i] + (entities.y[i] - entities.previousY[i]) * alpha;
+        const float elevation = entities.previousElevation[i] + (entities.elevation[i] - entities.previousElevation[i]) * alpha;
+        // Same terms as WorldToScreen
+        const float screenX = (x - y) * halfW - camera.x;
+        const float screenY = (x + y) * halfH - elevation * camera.zoom - camera.y;
+        // The figure spans its width around screenX and rises above screenY
+        if (screenX + ENTITY_WIDTH < 0 || screenX - ENTITY_WIDTH > SCREEN_WIDTH ||
+            screenY < 0 || screenY - ENTITY_HEIGHT - ENTITY_HEAD_SIZE > SCREEN_HEIGHT) {
+            continue;
+        }
+        sprites.push_back({x + y, elevation, screenX, screenY, entities.color[i]});
+    }
+    std::sort(sprites.begin(), sprites.end(), [](const Sprite& a, const Sprite& b) {
+        return a.depth != b.depth ? a.depth < b.depth : a.elevation < b.elevation;
+    });
+
+    const SDL_Color outline = {0, 0, 0, 255};
+    for (const Sprite& sprite : sprites) {
+        const float left = std::floor(sprite.screenX) - ENTITY_WIDTH / 2;
+        const float feet = std::floor(sprite.screenY);
+        const float headLeft = std::floor(sprite.screenX) - ENTITY_HEAD_SIZE / 2;
+        const float headTop = feet - ENTITY_HEIGHT - ENTITY_HEAD_SIZE;
+        // Outline quads with the fill inset by a pixel on top, as RenderPlayer draws its rects
+        AddQuad(left, feet - ENTITY_HEIGHT, ENTITY_WIDTH, ENTITY_HEIGHT, outline);
+        AddQuad(left + 1, feet - ENTITY_HEIGHT + 1, ENTITY_WIDTH - 2, ENTITY_HEIGHT - 2, sprite.color);
+        AddQuad(headLeft, headTop, ENTITY_HEAD_SIZE, ENTITY_HEAD_SIZE, outline);
+        AddQuad(headLeft + 1, headTop + 1, ENTITY_HEAD_SIZE - 2, ENTITY_HEAD_SIZE - 2, sprite.color);
+    }
+    return static_cast<int>(sprites.size());
+}
+
+void EntityBatch::AddQuad(float left, float top, float width, float height, SDL_Color color) {
+    const int base = static_cast<int>(vertices.size());
+    vertices.push_back({{left, top}, color, {0, 0}});
+    vertices.push_back({{left + width, top}, color, {0, 0}});
+    vertices.push_back({{left + width, top + height}, color, {0, 0}});
+    vertices.push_back({{left, top + height}, color, {0, 0}});
+    indices.insert(indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+}
+
+void EntityBatch::Draw(SDL_Renderer* renderer) const {
+    if (indices.empty()) return;
+    SDL_RenderGeometry(renderer, nullptr,
+                       vertices.data(), static_cast<int>(vertices.size()),
+                       indices.data(), static_cast<int>(indices.size()));
+}
+
+// Drawn for tiles whose chunk is still being generated
+static const SDL_Color kPlaceholderColor = {60, 60, 72, 255};
+
+int BatchVisibleTiles(const TerrainSource& terrain, const VisibleTileRange& visible,
+                      const Camera& camera, TileBatch& batch) {
+    // Spans are projected in pieces of this many tiles into stack buffers
+    const int kProjectChunk = 64;
+    int screenX[kProjectChunk];
+    int screenY[kProjectChunk];
+
+    int visited = 0;
+    const float scale = camera.zoom;
+    const RowProjector projector(camera);
+    for (int y = visible.yBegin; y < visible.yEnd; y++) {
+        const int rowEnd = visible.RowEnd(y);
+        for (int x = visible.RowBegin(y); x < rowEnd;) {
+            const TerrainBlock block = terrain.BlockAt(x, y);
+            const int blockEnd = std::min(rowEnd, block.originX + block.width);
+            if (block.tiles) {
+                // Culling only streams the elevation and color rows of the block; compact
+                // blocks stream the biome row and decode the color instead
+                const WorldTiles& tiles = *block.tiles;
+                const int localY = y - block.originY;
+                const int16_t* elevationRow = tiles.elevation.Row(localY);
+                const SDL_Color* colorRow = tiles.StoresColor() ? tiles.color.Row(localY) : nullptr;
+                const BiomeType* biomeRow = tiles.biome.Row(localY);
+                for (; x < blockEnd; x += kProjectChunk) {
+                    const int localX = x - block.originX;
+                    const int count = std::min(kProjectChunk, blockEnd - x);
+                    projector.Row(y, x).Project(elevationRow + localX, count, screenX, screenY);
+                    visited += count;
 
-    // Only render if tile is potentially visible (with margin)
-    if (screenX + TILE_WIDTH > 0 && screenX - TILE_WIDTH < SCREEN_WIDTH &&
-        screenY + TILE_HEIGHT > 0 && screenY - TILE_HEIGHT < SCREEN_HEIGHT) {
-
-        // Draw filled tile for better visibility
-        SDL_SetRenderDrawColor(renderer, tile.color.r, tile.color.g, tile.color.b, tile.color.a);
-
-        // Draw as filled polygon by creating triangles (simple approach for isometric diamond)
-        // This can be improved with SDL_RenderGeometry for more robust polygon filling if needed.
-        // For a simple diamond, two triangles suffice: (Top, Right, Bottom) and (Top, Bottom, Left)
-        SDL_Vertex vertices[4] = {
-            { { (float)points[0].x, (float)points[0].y }, tile.color, { 0, 0 } }, // Top
-            { { (float)points[1].x, (float)points[1].y }, tile.color, { 0, 0 } }, // Right
-            { { (float)points[2].x, (float)points[2].y }, tile.color, { 0, 0 } }, // Bottom
-            { { (float)points[3].x, (float)points[3].y }, tile.color, { 0, 0 } }  // Left
-        };
-
-        // Triangle 1: Top, Right, Bottom
-        // Triangle 2: Top, Bottom, Left
-        // Indices for SDL_RenderGeometry.
-        // If not using SDL_RenderGeometry, this part needs manual triangle drawing calls or line drawing.
-        // The original code used line drawing which doesn't actually fill.
-        // Let's stick to the original line drawing for now to maintain behavior, then improve.
-        // The original code's "filled polygon by creating triangles" was actually just drawing lines *between* points of triangles.
-        // For true filling, SDL_gfx or SDL_RenderGeometry would be better.
-        // Replicating original line drawing:
-        // for (int i = 1; i < 3; i++) {
-        //     SDL_RenderDrawLine(renderer, points[0].x, points[0].y, points[i].x, points[i].y);
-        //     SDL_RenderDrawLine(renderer, points[0].x, points[0].y, points[i+1].x, points[i+1].y);
-        //     SDL_RenderDrawLine(renderer, points[i].x, points[i].y, points[i+1].x, points[i+1].y);
-        // }
-        // A simpler way to draw a filled diamond shape with lines (though not truly filled):
-        // Draw lines from center to each point, then connect points.
-        // However, to match the original's attempt at filling with lines:
-        SDL_RenderDrawLine(renderer, points[0].x, points[0].y, points[1].x, points[1].y); // Top to Right
-        SDL_RenderDrawLine(renderer, points[1].x, points[1].y, points[2].x, points[2].y); // Right to Bottom
-        SDL_RenderDrawLine(renderer, points[2].x, points[2].y, points[3].x, points[3].y); // Bottom to Left
-        SDL_RenderDrawLine(renderer, points[3].x, points[3].y, points[0].x, points[0].y); // Left to Top
-        // To make it look more "filled" with lines, also draw diagonals:
-        SDL_RenderDrawLine(renderer, points[0].x, points[0].y, points[2].x, points[2].y); // Top to Bottom
-        SDL_RenderDrawLine(renderer, points[1].x, points[1].y, points[3].x, points[3].y); // Right to Left
-
-
-        // Draw outline for clarity
-        SDL_SetRenderDrawColor(renderer,
-            tile.color.r > 128 ? tile.color.r - 40 : tile.color.r + 40,
-            tile.color.g > 128 ? tile.color.g - 40 : tile.color.g + 40,
-            tile.color.b > 128 ? tile.color.b - 40 : tile.color.b + 40,
-            255);
-
-        for (int i = 0; i < 4; i++) {
-            SDL_RenderDrawLine(renderer,
-                points[i].x, points[i].y,
-                points[i + 1].x, points[i + 1].y);
+                    // Exact check for the tiles on the border of the visible range
+                    for (int i = 0; i < count; i++) {
+                        if (IsTileOnScreen(screenX[i], screenY[i], scale)) {
+                            const SDL_Color color = colorRow ? colorRow[localX + i]
+                                                             : TileColor(biomeRow[localX + i], x + i, y, tiles.seed,
+                                                                         tiles.worldWidth, tiles.worldHeight);
+                            batch.AddTile(screenX[i], screenY[i], color, scale);
+                        }
+                    }
+                }
+            } else {
+                // Not generated yet: flat placeholder tiles instead of waiting for the chunk
+                const RowProjection row = projector.Row(y, x);
+                for (int i = 0; i < blockEnd - x; i++) {
+                    const int tileX = row.ScreenX(i);
+                    const int tileY = row.ScreenY(i, INITIAL_ELEVATION);
+                    visited++;
+                    if (IsTileOnScreen(tileX, tileY, scale)) {
+                        batch.AddTile(tileX, tileY, kPlaceholderColor, scale);
+                    }
+                }
+            }
+            x = blockEnd;
         }
     }
+    return visited;
+}
+
+// Renders a single tile
+// Goes through a one-tile batch so it looks exactly like tiles drawn by the frame batch.
+void RenderTile(SDL_Renderer* renderer, const Tile& tile, const Camera& camera) {
+    TileBatch batch;
+    if (batch.AddTile(tile, camera)) {
+        batch.Draw(renderer);
+    }
 }
 
 // Renders the player
 void RenderPlayer(SDL_Renderer* renderer, const Player& player, const Camera& camera) {
-    // Player should always be at the center of the screen now
-    // The 'camera' parameter might seem redundant if player is always screen center,
-    // but WorldToScreen uses it, and it's good practice for a RenderPlayer function.
-    // For this specific implementation where player is screen center:
-    int screenX = SCREEN_WIDTH / 2;
-    int screenY = SCREEN_HEIGHT / 2;
+    // Projected like any tile, so the player drifts off center while the camera catches up
+    int screenX, screenY;
+    WorldToScreen(player.x, player.y, player.elevation, screenX, screenY, camera);
 
     // Draw player body (rectangle)
     SDL_SetRenderDrawColor(renderer, player.color.r, player.color.g, player.color.b, player.color.a);
@@ -0,0 +1,221 @@
+#include "Telemetry.h"
+#include <cstring>    // For std::strcmp
+
+bool ParseLogLevel(const char* text, LogLevel& out) {
+    static const struct { const char* name; LogLevel level; } kLevels[] = {
+        {"debug", LogLevel::Debug}, {"info", LogLevel::Info}, {"warning", LogLevel::Warning},
+        {"error", LogLevel::Error}, {"off", LogLevel::Off},
+    };
+    for (const auto& entry : kLevels) {
+        if (std::strcmp(text, entry.name) == 0) {
+            out = entry.level;
+            return true;
+        }
+    }
+    return false;
+}
+
+#if TELEMETRY_ENABLED
+
+#include <algorithm>          // For std::min
+#include <chrono>             // For the flush interval
+#include <condition_variable>
+#include <cstdarg>            // For va_list in TelemetryLog
+#include <cstdio>             // For std::vsnprintf
+#include <iostream>           // Logger output
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Messages waiting for the logger beyond this are dropped
+static const size_t kMessageQueueCapacity = 256;
+// Longer messages are cut off
+static const size_t kMessageChars = 160;
+// Queued messages are printed at least this often, even with a long metric interval
+static const double kMessagePollSeconds = 0.1;
+
+namespace {
+
+struct Metric {
+    std::string name;
+    LogLevel level;
+    std::unique_ptr<TelemetryCounter> counter; // Exactly one of counter and gauge is set
+    std::unique_ptr<TelemetryGauge> gauge;
+};
+
+struct Message {
+    LogLevel level;
+    char text[kMessageChars];
+};
+
+const char* LevelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::Debug:   return "debug";
+        case LogLevel::Info:    return "info";
+        case LogLevel::Warning: return "warning";
+        case LogLevel::Error:   return "error";
+        default:                return "off";
+    }
+}
+
+class TelemetryState {
+public:
+    TelemetryState() {
+        queue.reserve(kMessageQueueCapacity);
+        printing.reserve(kMessageQueueCapacity);
+    }
+    ~TelemetryState() { Stop(); }
+
+    Metric& Register(const char* name, LogLevel metricLevel, bool isCounter) {
+        std::lock_guard<std::mutex> lock(metricsMutex);
+        for (const std::unique_ptr<Metric>& metric : metrics) {
+            if (metric->name == name && (metric->counter != nullptr) == isCounter) return *metric;
+        }
+        auto metric = std::make_unique<Metric>();
+        metric->name = name;
+        metric->level = metricLevel;
+        if (isCounter) metric->counter = std::make_unique<TelemetryCounter>();
+        else metric->gauge = std::make_unique<TelemetryGauge>();
+        metrics.push_back(std::move(metric));
+        return *metrics.back();
+    }
+
+    void Start(LogLevel newLevel, double newFlushSeconds) {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if (logger.joinable()) return;
+        level.store(newLevel, std::memory_order_relaxed);
+        flushSeconds = newFlushSeconds;
+        stopping = false;
+        logger = std::thread(&TelemetryState::LoggerLoop, this);
+    }
+
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            if (!logger.joinable()) return;
+            stopping = true;
+        }
+        wake.notify_one();
+        logger.join();
+    }
+
+    bool Accepts(LogLevel messageLevel) const {
+        return messageLevel >= level.load(std::memory_order_relaxed) && messageLevel != LogLevel::Off;
+    }
+
+    void Push(const Message& message) {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if (queue.size() < kMessageQueueCapacity) {
+            queue.push_back(message);
+        } else {
+            dropped++;
+        }
+    }
+
+private:
+    void LoggerLoop() {
+        using Clock = std::chrono::steady_clock;
+        const auto interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(flushSeconds));
+        const auto poll = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(kMessagePollSeconds));
+        auto nextFlush = Clock::now() + interval;
+
+        std::unique_lock<std::mutex> lock(queueMutex);
+        while (true) {
+            wake.wait_until(lock, std::min(nextFlush, Clock::now() + poll), [&] { return stopping; });
+            const bool stop = stopping;
+            // Print outside the lock so producers never wait on the console
+            printing.swap(queue);
+            const size_t droppedNow = dropped;
+            dropped = 0;
+            lock.unlock();
+
+            PrintMessages(droppedNow);
+            if (stop || Clock::now() >= nextFlush) {
+                PrintMetrics();
+                nextFlush = Clock::now() + interval;
+            }
+            std::cout.flush();
+
+            lock.lock();
+            if (stop) return;
+        }
+    }
+
+    void PrintMessages(size_t droppedCount) {
+        for (const Message& message : printing) {
+            std::cout << '[' << LevelName(message.level) << "] " << message.text << '\n';
+        }
+        printing.clear();
+        if (droppedCount > 0) {
+            std::cout << "[warning] telemetry dropped " << droppedCount << " messages\n";
+        }
+    }
+
+    void PrintMetrics() {
+        const LogLevel minLevel = level.load(std::memory_order_relaxed);
+        bool any = false;
+        std::lock_guard<std::mutex> lock(metricsMutex);
+        for (const std::unique_ptr<Metric>& metric : metrics) {
+            if (metric->level < minLevel) continue;
+            std::cout << (any ? " " : "[telemetry] ") << metric->name << '=';
+            if (metric->counter) std::cout << metric->counter->Value();
+            else std::cout << metric->gauge->Value();
+            any = true;
+        }
+        if (any) std::cout << '\n';
+    }
+
+    std::mutex metricsMutex;
+    std::vector<std::unique_ptr<Metric>> metrics; // Guarded by metricsMutex, in registration order
+
+    std::mutex queueMutex;
+    std::condition_variable wake;
+    std::vector<Message> queue;    // Guarded by queueMutex
+    std::vector<Message> printing; // Logger thread only; swapped with queue to drain it
+    size_t dropped = 0;            // Guarded by queueMutex
+    bool stopping = false;         // Guarded by queueMutex
+    std::thread logger;
+
+    std::atomic<LogLevel> level{LogLevel::Info};
+    double flushSeconds = TELEMETRY_FLUSH_SECONDS;
+};
+
+TelemetryState& State() {
+    static TelemetryState state;
+    return state;
+}
+
+} // namespace
+
+TelemetryCounter& RegisterCounter(const char* name, LogLevel level) {
+    return *State().Register(name, level, true).counter;
+}
+
+TelemetryGauge& RegisterGauge(const char* name, LogLevel level) {
+    return *State().Register(name, level, false).gauge;
+}
+
+void StartTelemetry(LogLevel level, double flushSeconds) {
+    State().Start(level, flushSeconds);
+}
+
+void StopTelemetry() {
+    State().Stop();
+}
+
+void TelemetryLog(LogLevel level, const char* format, ...) {
+    TelemetryState& state = State();
+    if (!state.Accepts(level)) return;
+
+    Message message;
+    message.level = level;
+    va_list args;
+    va_start(args, format);
+    std::vsnprintf(message.text, sizeof(message.text), format, args);
+    va_end(args);
+    state.Push(message);
+}
+
+#endif // TELEMETRY_ENABLED
@@ -0,0 +1,103 @@
+#include "TerrainLod.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+ElevationRange RectElevationRange(const WorldTiles& tiles, int minX, int minY, int maxX, int maxY) {
+    ElevationRange range;
+    range.min = range.max = tiles.elevation(minX, minY);
+    for (int y = minY; y <= maxY; ++y) {
+        for (int x = minX; x <= maxX; ++x) {
+            range.min = std::min<int>(range.min, tiles.elevation(x, y));
+            range.max = std::max<int>(range.max, tiles.elevation(x, y));
+        }
+    }
+    return range;
+}
+} // namespace
+
+TerrainLod::TerrainLod(const WorldTiles& world, int maxLevels) : world(world) {
+    int width = world.Width();
+    int height = world.Height();
+    for (int level = 1; level < maxLevels && (width > 1 || height > 1); ++level) {
+        width = (width + 1) / 2;
+        height = (height + 1) / 2;
+        levels.emplace_back(width, height);
+    }
+    for (int level = 1; level <= static_cast<int>(levels.size()); ++level) {
+        BuildCells(level, 0, 0, levels[level - 1].Width() - 1, levels[level - 1].Height() - 1);
+    }
+
+    // Sources keep references, so they are made once the levels stop moving
+    sources.push_back(std::make_unique<WorldTilesSource>(world));
+    for (const WorldTiles& cells : levels) {
+        sources.push_back(std::make_unique<WorldTilesSource>(cells));
+    }
+}
+
+// Cells [minX, maxX] x [minY, maxY] of level, straight from the tiles they cover
+void TerrainLod::BuildCells(int level, int minX, int minY, int maxX, int maxY) {
+    WorldTiles& cells = levels[level - 1];
+    const int size = 1 << level;
+    for (int cy = minY; cy <= maxY; ++cy) {
+        for (int cx = minX; cx <= maxX; ++cx) {
+            const int x0 = cx * size;
+            const int y0 = cy * size;
+            const int x1 = std::min(x0 + size, world.Width());
+            const int y1 = std::min(y0 + size, world.Height());
+
+            long elevation = 0;
+            long r = 0, g = 0, b = 0;
+            bool walkable = false;
+            for (int y = y0; y < y1; ++y) {
+                const int16_t* elevationRow = world.elevation.Row(y);
+                for (int x = x0; x < x1; ++x) {
+                    const SDL_Color color = world.ColorAt(x, y);
+                    elevation += elevationRow[x];
+                    r += color.r;
+                    g += color.g;
+                    b += color.b;
+                    walkable = walkable || world.IsWalkable(x, y);
+                }
+            }
+            const long count = static_cast<long>(x1 - x0) * (y1 - y0);
+            // Mean elevation in level units, rounded to the nearest
+            cells.elevation(cx, cy) = static_cast<int16_t>(std::lround(static_cast<double>(elevation) / (count * size)));
+            cells.color(cx, cy) = {static_cast<Uint8>(r / count), static_cast<Uint8>(g / count),
+                                   static_cast<Uint8>(b / count), 255};
+            cells.biome(cx, cy) = world.biome((x0 + x1 - 1) / 2, (y0 + y1 - 1) / 2);
+            cells.SetWalkable(cx, cy, walkable);
+        }
+    }
+}
+
+void TerrainLod::Update(int minX, int minY, int maxX, int maxY) {
+    minX = std::max(minX, 0);
+    minY = std::max(minY, 0);
+    maxX = std::min(maxX, world.Width() - 1);
+    maxY = std::min(maxY, world.Height() - 1);
+    if (maxX < minX || maxY < minY) return;
+
+    sources[0]->IncludeElevations(RectElevationRange(world, minX, minY, maxX, maxY));
+    for (int level = 1; level < LevelCount(); ++level) {
+        BuildCells(level, minX >> level, minY >> level, maxX >> level, maxY >> level);
+        sources[level]->IncludeElevations(RectElevationRange(levels[level - 1], minX >> level, minY >> level,
+                                                             maxX >> level, maxY >> level));
+    }
+}
+
+int TerrainLod::LevelForZoom(float zoom) const {
+    if (zoom >= 1.0f) return 0;
+    const int level = static_cast<int>(std::floor(std::log2(1.0f / zoom)));
+    return std::clamp(level, 0, LevelCount() - 1);
+}
+
+Camera TerrainLod::LevelCamera(const Camera& camera, int level) {
+    // Cell (cx, cy) covers tiles whose center lies at cx * size + (size - 1) / 2. In x - y the
+    // half-tile shifts cancel; in x + y they leave (size - 1) tiles of vertical offset.
+    const int size = 1 << level;
+    Camera levelCamera = camera;
+    levelCamera.zoom = camera.zoom * size;
+    levelCamera.y = camera.y - (size - 1) * (TILE_HEIGHT / 2.0f) * camera.zoom;
+    return levelCamera;
+}
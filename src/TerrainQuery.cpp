@@ -0,0 +1,246 @@
+#include "TerrainQuery.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+// The four tile centers around a position and its weights between them
+struct Footprint {
+    int x0, y0;  // top-left tile, the others are +1 in x and y
+    float tx, ty;
+};
+
+Footprint FootprintAt(float x, float y) {
+    const float fx = x - 0.5f;
+    const float fy = y - 0.5f;
+    Footprint footprint;
+    footprint.x0 = static_cast<int>(std::floor(fx));
+    footprint.y0 = static_cast<int>(std::floor(fy));
+    footprint.tx = fx - footprint.x0;
+    footprint.ty = fy - footprint.y0;
+    return footprint;
+}
+
+float Blend(float e00, float e10, float e01, float e11, float tx, float ty) {
+    const float top = e00 + (e10 - e00) * tx;
+    const float bottom = e01 + (e11 - e01) * tx;
+    return top + (bottom - top) * ty;
+}
+
+bool BlockHoldsFootprint(const TerrainBlock& block, const Footprint& f) {
+    return block.tiles && f.x0 >= block.originX && f.x0 + 1 < block.originX + block.width &&
+           f.y0 >= block.originY && f.y0 + 1 < block.originY + block.height;
+}
+
+// All four tiles in one resident block: read its rows directly
+float BlockHeight(const TerrainBlock& block, const Footprint& f) {
+    const int x = f.x0 - block.originX;
+    const int y = f.y0 - block.originY;
+    const int16_t* row0 = block.tiles->elevation.Row(y);
+    const int16_t* row1 = block.tiles->elevation.Row(y + 1);
+    return Blend(row0[x], row0[x + 1], row1[x], row1[x + 1], f.tx, f.ty);
+}
+
+// Footprint straddles a block edge or missing tiles: look each tile up
+float SourceHeight(const TerrainSource& terrain, const Footprint& f) {
+    return Blend(static_cast<float>(terrain.ElevationAt(f.x0, f.y0)),
+                 static_cast<float>(terrain.ElevationAt(f.x0 + 1, f.y0)),
+                 static_cast<float>(terrain.ElevationAt(f.x0, f.y0 + 1)),
+                 static_cast<float>(terrain.ElevationAt(f.x0 + 1, f.y0 + 1)), f.tx, f.ty);
+}
+
+// Walkability lookups that reuse the last block while the walk stays inside it
+class WalkableCursor {
+public:
+    explicit WalkableCursor(const TerrainSource& terrain) : terrain(terrain) {}
+
+    bool operator()(int x, int y) {
+        if (x < block.originX || x >= block.originX + block.width ||
+            y < block.originY || y >= block.originY + block.height) {
+            block = terrain.BlockAt(x, y);
+        }
+        return block.tiles && block.tiles->IsWalkable(x - block.originX, y - block.originY);
+    }
+
+private:
+    const TerrainSource& terrain;
+    TerrainBlock block{nullptr, 0, 0, 0, 0};
+};
+
+bool WalkSegment(WalkableCursor& walkable, float x0, float y0, float x1, float y1) {
+    // Grid traversal (Amanatides & Woo): step into whichever tile edge the segment crosses next
+    int tileX = static_cast<int>(std::floor(x0));
+    int tileY = static_cast<int>(std::floor(y0));
+    const int endX = static_cast<int>(std::floor(x1));
+    const int endY = static_cast<int>(std::floor(y1));
+    if (!walkable(tileX, tileY)) return false;
+
+    const float infinity = std::numeric_limits<float>::infinity();
+    const float dx = x1 - x0;
+    const float dy = y1 - y0;
+    const int stepX = dx > 0.0f ? 1 : -1;
+    const int stepY = dy > 0.0f ? 1 : -1;
+    const float deltaX = dx != 0.0f ? 1.0f / std::abs(dx) : infinity;
+    const float deltaY = dy != 0.0f ? 1.0f / std::abs(dy) : infinity;
+    float nextX = dx != 0.0f ? (dx > 0.0f ? tileX + 1 - x0 : x0 - tileX) * deltaX : infinity;
+    float nextY = dy != 0.0f ? (dy > 0.0f ? tileY + 1 - y0 : y0 - tileY) * deltaY : infinity;
+
+    // Exactly one tile edge per step, so the walk ends on the end tile
+    const int steps = std::abs(endX - tileX) + std::abs(endY - tileY);
+    for (int i = 0; i < steps; ++i) {
+        if (nextX < nextY) {
+            tileX += stepX;
+            nextX += deltaX;
+        } else {
+            tileY += stepY;
+            nextY += deltaY;
+        }
+        if (!walkable(tileX, tileY)) return false;
+    }
+    return true;
+}
+} // namespace
+
+float HeightAt(const TerrainSource& terrain, float x, float y) {
+    const Footprint footprint = FootprintAt(x, y);
+    const TerrainBlock block = terrain.BlockAt(footprint.x0, footprint.y0);
+    return BlockHoldsFootprint(block, footprint) ? BlockHeight(block, footprint) : SourceHeight(terrain, footprint);
+}
+
+void HeightsAt(const TerrainSource& terrain, const float* xs, const float* ys, float* heights, size_t count) {
+    TerrainBlock block{nullptr, 0, 0, 0, 0};
+    for (size_t i = 0; i < count; ++i) {
+        const Footprint footprint = FootprintAt(xs[i], ys[i]);
+        if (!BlockHoldsFootprint(block, footprint)) {
+            block = terrain.BlockAt(footprint.x0, footprint.y0);
+        }
+        heights[i] = BlockHoldsFootprint(block, footprint) ? BlockHeight(block, footprint)
+                                                           : SourceHeight(terrain, footprint);
+    }
+}
+
+bool SegmentWalkable(const TerrainSource& terrain, float x0, float y0, float x1, float y1) {
+    WalkableCursor walkable(terrain);
+    return WalkSegment(walkable, x0, y0, x1, y1);
+}
+
+void SegmentsWalkable(const TerrainSource& terrain, const float* x0s, const float* y0s,
+                      const float* x1s, const float* y1s, uint8_t* walkable, size_t count) {
+    WalkableCursor cursor(terrain);
+    for (size_t i = 0; i < count; ++i) {
+        walkable[i] = WalkSegment(cursor, x0s[i], y0s[i], x1s[i], y1s[i]) ? 1 : 0;
+    }
+}
+
+ElevationPyramid::ElevationPyramid(const WorldTiles& world) : world(world) {
+    int width = world.Width();
+    int height = world.Height();
+    while (width > 1 || height > 1) {
+        width = (width + 1) / 2;
+        height = (height + 1) / 2;
+        levels.emplace_back(width, height);
+    }
+    Update(0, 0, world.Width() - 1, world.Height() - 1);
+}
+
+ElevationSpan ElevationPyramid::Span(int level, int bx, int by) const {
+    if (level == 0) {
+        const int16_t elevation = world.elevation(bx, by);
+        return {elevation, elevation};
+    }
+    return levels[level - 1](bx, by);
+}
+
+void ElevationPyramid::Update(int minX, int minY, int maxX, int maxY) {
+    minX = std::max(minX, 0);
+    minY = std::max(minY, 0);
+    maxX = std::min(maxX, world.Width() - 1);
+    maxY = std::min(maxY, world.Height() - 1);
+    if (maxX < minX || maxY < minY) return;
+
+    int childWidth = world.Width();
+    int childHeight = world.Height();
+    for (int level = 1; level < LevelCount(); ++level) {
+        minX >>= 1;
+        minY >>= 1;
+        maxX >>= 1;
+        maxY >>= 1;
+        WorldGrid<ElevationSpan>& blocks = levels[level - 1];
+        for (int by = minY; by <= maxY; ++by) {
+            for (int bx = minX; bx <= maxX; ++bx) {
+                ElevationSpan span = Span(level - 1, bx * 2, by * 2);
+                for (int cy = by * 2; cy < std::min(by * 2 + 2, childHeight); ++cy) {
+                    for (int cx = bx * 2; cx < std::min(bx * 2 + 2, childWidth); ++cx) {
+                        const ElevationSpan child = Span(level - 1, cx, cy);
+                        span.min = std::min(span.min, child.min);
+                        span.max = std::max(span.max, child.max);
+                    }
+                }
+                blocks(bx, by) = span;
+            }
+        }
+        childWidth = blocks.Width();
+        childHeight = blocks.Height();
+    }
+}
+
+struct ElevationPyramid::Segment {
+    float x0, y0, z0;
+    float dx, dy, dz;
+};
+
+// First hit of the segment inside block (bx, by) of level within [tBegin, tEnd], or -1
+float ElevationPyramid::Trace(const Segment& s, int level, int bx, int by, float tBegin, float tEnd) const {
+    const float minX = static_cast<float>(bx << level);
+    const float minY = static_cast<float>(by << level);
+    const float maxX = static_cast<float>(std::min((bx + 1) << level, world.Width()));
+    const float maxY = static_cast<float>(std::min((by + 1) << level, world.Height()));
+
+    // Clip the parameter range to the block's footprint
+    auto clip = [&](float origin, float direction, float low, float high) {
+        if (direction == 0.0f) {
+            if (origin < low || origin > high) tEnd = -1.0f;
+            return;
+        }
+        float tLow = (low - origin) / direction;
+        float tHigh = (high - origin) / direction;
+        if (tLow > tHigh) std::swap(tLow, tHigh);
+        tBegin = std::max(tBegin, tLow);
+        tEnd = std::min(tEnd, tHigh);
+    };
+    clip(s.x0, s.dx, minX, maxX);
+    clip(s.y0, s.dy, minY, maxY);
+    if (tBegin > tEnd) return -1.0f;
+
+    const float zBegin = s.z0 + s.dz * tBegin;
+    const float zEnd = s.z0 + s.dz * tEnd;
+    const ElevationSpan span = Span(level, bx, by);
+    if (std::min(zBegin, zEnd) >= span.max) return -1.0f; // passes over everything here
+    if (zBegin < span.min) return tBegin; // enters below every tile here
+    if (level == 0) {
+        // Enters above the tile and leaves below it, so the segment descends
+        return std::clamp((span.max - s.z0) / s.dz, tBegin, tEnd);
+    }
+
+    // Visit the children front to back so the first hit found is the nearest one.
+    // A segment crosses at most three of the four, so the middle pair's order does not matter.
+    const int nearX = s.dx >= 0.0f ? 0 : 1;
+    const int nearY = s.dy >= 0.0f ? 0 : 1;
+    const int order[4][2] = {{nearX, nearY}, {1 - nearX, nearY}, {nearX, 1 - nearY}, {1 - nearX, 1 - nearY}};
+    const int childWidth = level == 1 ? world.Width() : levels[level - 2].Width();
+    const int childHeight = level == 1 ? world.Height() : levels[level - 2].Height();
+    for (const auto& child : order) {
+        const int cx = bx * 2 + child[0];
+        const int cy = by * 2 + child[1];
+        if (cx >= childWidth || cy >= childHeight) continue;
+        const float hit = Trace(s, level - 1, cx, cy, tBegin, tEnd);
+        if (hit >= 0.0f) return hit;
+    }
+    return -1.0f;
+}
+
+float ElevationPyramid::Raycast(float x0, float y0, float z0, float x1, float y1, float z1) const {
+    if (world.Width() == 0 || world.Height() == 0) return -1.0f;
+    const Segment segment = {x0, y0, z0, x1 - x0, y1 - y0, z1 - z0};
+    return Trace(segment, LevelCount() - 1, 0, 0, 0.0f, 1.0f);
+}
@@ -0,0 +1,25 @@
+#include "TerrainSource.h"
+#include <algorithm>
+
+ElevationRange ComputeElevationRange(const WorldTiles& world) {
+    ElevationRange range;
+    if (world.Width() == 0 || world.Height() == 0) return range;
+
+    range.min = range.max = world.elevation(0, 0);
+    for (int y = 0; y < world.Height(); ++y) {
+        const int16_t* row = world.elevation.Row(y);
+        for (int x = 0; x < world.Width(); ++x) {
+            range.min = std::min<int>(range.min, row[x]);
+            range.max = std::max<int>(range.max, row[x]);
+        }
+    }
+    return range;
+}
+
+TerrainBlock WorldTilesSource::BlockAt(int x, int y) const {
+    if (world.InBounds(x, y)) {
+        return {&world, 0, 0, world.Width(), world.Height()};
+    }
+    // Outside the grid: report a single empty tile so span walks step one tile at a time
+    return {nullptr, x, y, 1, 1};
+}
@@ -0,0 +1,83 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+ThreadPool::ThreadPool(unsigned threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    // The calling thread always takes band 0, so only threadCount - 1 workers are spawned
+    for (unsigned i = 1; i < threadCount; ++i) {
+        workers.emplace_back(&ThreadPool::WorkerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::RunBand(unsigned band) {
+    // Even split; the first (length % bands) bands get one extra element
+    int length = jobEnd - jobBegin;
+    int base = length / static_cast<int>(jobBands);
+    int extra = length % static_cast<int>(jobBands);
+    int b = static_cast<int>(band);
+    int bandBegin = jobBegin + b * base + std::min(b, extra);
+    int bandEnd = bandBegin + base + (b < extra ? 1 : 0);
+    if (bandBegin < bandEnd) {
+        (*job)(bandBegin, bandEnd);
+    }
+}
+
+void ThreadPool::WorkerLoop(unsigned workerIndex) {
+    unsigned long long seenGeneration = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || generation != seenGeneration; });
+            if (stopping) return;
+            seenGeneration = generation;
+            if (workerIndex >= jobBands) continue; // Not enough work for this worker
+        }
+
+        RunBand(workerIndex);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--pendingBands == 0) {
+            finished.notify_one();
+        }
+    }
+}
+
+void ThreadPool::ParallelFor(int begin, int end, const std::function<void(int, int)>& body) {
+    if (begin >= end) return;
+
+    unsigned bands = std::min(ThreadCount(), static_cast<unsigned>(end - begin));
+    if (bands == 1) {
+        body(begin, end);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &body;
+        jobBegin = begin;
+        jobEnd = end;
+        jobBands = bands;
+        pendingBands = bands - 1; // Band 0 runs on the calling thread
+        ++generation;
+    }
+    wake.notify_all();
+
+    RunBand(0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [&] { return pendingBands == 0; });
+    job = nullptr;
+}
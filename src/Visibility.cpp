@@ -0,0 +1,49 @@
+#include "Visibility.h"
+#include "GameConstants.h"
+#include <algorithm>
+#include <cmath>
+
+int VisibleTileRange::TileCount() const {
+    int count = 0;
+    for (size_t i = 0; i < xBegin.size(); ++i) {
+        count += std::max(0, xEnd[i] - xBegin[i]);
+    }
+    return count;
+}
+
+void ComputeVisibleTiles(float viewX, float viewY, float viewElevation, ElevationRange elevation,
+                         const TileBounds& bounds, VisibleTileRange& out, float zoom) {
+    const float halfW = TILE_WIDTH / 2.0f * zoom;
+    const float halfH = TILE_HEIGHT / 2.0f * zoom;
+
+    // WorldToScreen maps a tile at (rx, ry) relative to the view center to
+    //   screenX = (rx - ry) * halfW + SCREEN_WIDTH / 2
+    //   screenY = (rx + ry) * halfH - relativeElevation * zoom + SCREEN_HEIGHT / 2
+    // so the on-screen margins bound d = rx - ry and s = rx + ry independently.
+    // One extra tile on each side absorbs the integer truncation of the projection.
+    const float dMin = (-SCREEN_WIDTH / 2.0f - TILE_WIDTH * zoom) / halfW - 1.0f;
+    const float dMax = (SCREEN_WIDTH / 2.0f + TILE_WIDTH * zoom) / halfW + 1.0f;
+    const float top = -SCREEN_HEIGHT / 2.0f - (TILE_HEIGHT + TILE_DEPTH) * zoom;
+    const float bottom = SCREEN_HEIGHT / 2.0f + (TILE_HEIGHT + TILE_DEPTH) * zoom;
+    const float sMin = (top + (elevation.min - viewElevation) * zoom) / halfH - 1.0f;
+    const float sMax = (bottom + (elevation.max - viewElevation) * zoom) / halfH + 1.0f;
+
+    // Rows where the d and s bands can overlap at all
+    const float ryMin = (sMin - dMax) / 2.0f;
+    const float ryMax = (sMax - dMin) / 2.0f;
+    out.yBegin = std::clamp(static_cast<int>(std::floor(viewY + ryMin)), bounds.minY, bounds.maxY);
+    out.yEnd = std::clamp(static_cast<int>(std::ceil(viewY + ryMax)) + 1, out.yBegin, bounds.maxY);
+
+    const size_t rows = static_cast<size_t>(out.yEnd - out.yBegin);
+    out.xBegin.resize(rows);
+    out.xEnd.resize(rows);
+
+    for (int y = out.yBegin; y < out.yEnd; ++y) {
+        const float ry = y - viewY;
+        const float rxMin = std::max(dMin + ry, sMin - ry);
+        const float rxMax = std::min(dMax + ry, sMax - ry);
+        const size_t i = static_cast<size_t>(y - out.yBegin);
+        out.xBegin[i] = std::clamp(static_cast<int>(std::floor(viewX + rxMin)), bounds.minX, bounds.maxX);
+        out.xEnd[i] = std::clamp(static_cast<int>(std::ceil(viewX + rxMax)) + 1, out.xBegin[i], bounds.maxX);
+    }
+}
@@ -1,9 +1,14 @@
 #include "World.h"
 #include "GameConstants.h" // For WORLD_WIDTH, WORLD_HEIGHT, biome levels etc.
+#include "ThreadPool.h"    // For row-band parallel generation
+#include "Biomes.h"        // For the biome table and lookup
+#include "Telemetry.h"     // For generation counters
+#include <cstring>         // For std::memcpy
 #include <cmath>           // For std::sqrt, std::pow, std::abs, std::sin, std::cos, std::max, std::min
-#include <random>          // For std::random_device, std::mt19937, std::uniform_int_distribution
 #include <algorithm>       // For std::clamp, std::max, std::min (though cmath also has max/min)
-#include <iostream>        // For std::cout in GenerateWorld (debug output, might remove later)
+#include <chrono>          // For per-stage timings
+#include <iostream>        // For config validation messages
+#include <mutex>           // For merging per-thread stats
 
 // Simplified terrain height function (can be expanded or made more complex later)
 // This version was marked for debugging visibility in main.cpp
@@ -29,69 +34,165 @@ float GetTerrainHeight(float x, float y) {
 }
 
 // Function to determine biome based on elevation and moisture
+// Table lookup equivalent to the decision ladder in Biomes.h
 BiomeType DetermineBiome(float elevation, float moisture) {
-    // Water biomes based on depth
-    if (elevation < WATER_LEVEL - 5.0f) return BiomeType::DEEP_WATER;
-    if (elevation < WATER_LEVEL) return BiomeType::SHALLOW_WATER;
+    return LookupBiome(elevation, moisture);
+}
 
-    // Beach and coastal areas
-    if (elevation < BEACH_LEVEL) return BiomeType::BEACH;
+// Builds the noise generator used by every world and chunk generation call
+NoiseGenerator CreateWorldNoise(const WorldGenConfig& config) {
+    // Build every permutation table the layers below need up front. Layer base seeds are
+    // config.seed + 0..4 and each octave adds one, so the highest seed is base + octaves - 1.
+    const int seedCount = std::max({config.continentOctaves, 1 + config.terrainOctaves, 2 + 4,
+                                    3 + config.riverOctaves, 4 + 4});
+    return NoiseGenerator(static_cast<int>(config.seed), seedCount);
+}
 
-    // Lowlands - plains and forests based on moisture
-    if (elevation < PLAINS_LEVEL) {
-        if (moisture < 0.3f) return BiomeType::PLAINS; // Dry plains
-        if (moisture < 0.6f) return BiomeType::PLAINS; // Standard plains
-        return BiomeType::FOREST; // Forests in moist areas
+bool WorldGenConfig::Validate() const {
+    // Enough octaves to hit float precision long before the limit; larger values only cost time
+    const int kMaxOctaves = 16;
+    if (width <= 0 || height <= 0) {
+        std::cerr << "World size must be positive, got " << width << "x" << height << std::endl;
+        return false;
     }
-
-    // Hills and highlands
-    if (elevation < HILLS_LEVEL) {
-        if (moisture < 0.4f) return BiomeType::HILLS; // Dry hills
-        return BiomeType::FOREST; // Forested hills
+    if (static_cast<int64_t>(width) * height > (int64_t(1) << 28)) {
+        std::cerr << "World size " << width << "x" << height << " is too large" << std::endl;
+        return false;
+    }
+    for (int octaves : {continentOctaves, terrainOctaves, riverOctaves}) {
+        if (octaves < 1 || octaves > kMaxOctaves) {
+            std::cerr << "Octave counts must be between 1 and " << kMaxOctaves << ", got " << octaves << std::endl;
+            return false;
+        }
     }
+    if (!(riverThreshold > 0.0f && riverThreshold < 1.0f)) {
+        std::cerr << "River threshold must be between 0 and 1, got " << riverThreshold << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool WorldGenConfig::operator==(const WorldGenConfig& other) const {
+    return seed == other.seed && width == other.width && height == other.height &&
+           continentOctaves == other.continentOctaves && terrainOctaves == other.terrainOctaves &&
+           riverOctaves == other.riverOctaves && riverThreshold == other.riverThreshold;
+}
 
-    // Mountains and peaks
-    if (elevation < MOUNTAIN_LEVEL) {
-        return BiomeType::MOUNTAINS; // Rocky mountains
+// FNV-1a, fed whole values in a fixed little-endian byte order so hashes match across machines
+namespace {
+class StableHash {
+public:
+    void Add(uint64_t value, int bytes) {
+        for (int i = 0; i < bytes; ++i) {
+            hash ^= (value >> (8 * i)) & 0xFF;
+            hash *= 1099511628211ull;
+        }
     }
+    uint64_t Value() const { return hash; }
+
+private:
+    uint64_t hash = 1469598103934665603ull;
+};
+} // namespace
 
-    // Snow-capped peaks at highest elevations
-    return BiomeType::SNOW_CAPS;
+uint64_t WorldGenConfigHash(const WorldGenConfig& config) {
+    uint32_t thresholdBits;
+    std::memcpy(&thresholdBits, &config.riverThreshold, sizeof(thresholdBits));
+    StableHash hash;
+    hash.Add(WORLD_GENERATOR_VERSION, 4);
+    hash.Add(config.seed, 4);
+    hash.Add(static_cast<uint32_t>(config.width), 4);
+    hash.Add(static_cast<uint32_t>(config.height), 4);
+    hash.Add(static_cast<uint32_t>(config.continentOctaves), 4);
+    hash.Add(static_cast<uint32_t>(config.terrainOctaves), 4);
+    hash.Add(static_cast<uint32_t>(config.riverOctaves), 4);
+    hash.Add(thresholdBits, 4);
+    return hash.Value();
 }
 
-// Function to create biome properties map
-std::map<BiomeType, BiomeProperties> CreateBiomeProperties() {
-    return {
-        {BiomeType::DEEP_WATER,    {{0, 64, 220, 255},    0.3f, 0.1f, false}},
-        {BiomeType::SHALLOW_WATER, {{0, 128, 255, 255},   0.5f, 0.2f, false}},
-        {BiomeType::BEACH,         {{240, 220, 180, 255}, 0.6f, 0.2f, true}},
-        {BiomeType::PLAINS,        {{100, 210, 100, 255}, 1.0f, 0.3f, true}},
-        {BiomeType::FOREST,        {{21, 120, 35, 255},   1.1f, 0.4f, true}},
-        {BiomeType::HILLS,         {{90, 160, 90, 255},   1.2f, 0.6f, true}},
-        {BiomeType::MOUNTAINS,     {{150, 140, 130, 255}, 1.5f, 0.8f, false}},
-        {BiomeType::SNOW_CAPS,     {{255, 255, 255, 255}, 1.6f, 0.9f, false}}
-    };
+uint64_t WorldContentHash(const WorldTiles& world) {
+    StableHash hash;
+    hash.Add(static_cast<uint32_t>(world.Width()), 4);
+    hash.Add(static_cast<uint32_t>(world.Height()), 4);
+    for (int y = 0; y < world.Height(); ++y) {
+        const int16_t* elevation = world.elevation.Row(y);
+        const BiomeType* biome = world.biome.Row(y);
+        for (int x = 0; x < world.Width(); ++x) {
+            hash.Add(static_cast<uint16_t>(elevation[x]), 2);
+            hash.Add(static_cast<uint8_t>(biome[x]), 1);
+        }
+        // Bits past the last tile of a row are never set, so whole words can be hashed
+        const uint64_t* walkable = world.walkable.Row(y);
+        for (int word = 0; word < world.walkable.Width(); ++word) {
+            hash.Add(walkable[word], 8);
+        }
+    }
+    return hash.Value();
 }
 
-// World generation function
-std::vector<std::vector<Tile>> GenerateWorld() {
-    std::vector<std::vector<Tile>> world(WORLD_HEIGHT, std::vector<Tile>(WORLD_WIDTH));
-    std::vector<std::vector<TerrainData>> terrainData(WORLD_HEIGHT,
-        std::vector<TerrainData>(WORLD_WIDTH));
+// Generation stages
+// Each stage works on rows [rowBegin, rowEnd) of a grid whose (0, 0) cell is the world tile
+// (originX, originY), so the same code serves the whole world and single chunks.
+
+namespace {
+
+// Per-layer x inputs for one grid row. Sample x positions are the same for every row, so
+// they are built once and the noise is evaluated a whole row at a time.
+struct NoiseLayerInputs {
+    float* continent;
+    float* detail;
+    float* mountain;
+    float* moisture;
+    float* river;
+};
+
+// Noise layers sampled per row; row buffers hold kLayerCount * width floats
+constexpr int kLayerCount = 5;
 
-    auto biomeProps = CreateBiomeProperties();
+// storage holds kLayerCount * width floats and must outlive the returned inputs
+NoiseLayerInputs BuildLayerInputs(int originX, int width, float* storage) {
+    NoiseLayerInputs in{storage, storage + width, storage + 2 * width, storage + 3 * width, storage + 4 * width};
+    for (int x = 0; x < width; ++x) {
+        float nx = (originX + x) / float(WORLD_WIDTH);
+        in.continent[x] = nx * 0.5f;
+        in.detail[x] = nx * 5.0f;
+        in.mountain[x] = nx * 3.0f;
+        in.moisture[x] = nx * 4.0f;
+        in.river[x] = nx * 8.0f;
+    }
+    return in;
+}
+
+// Stage 1: noise layers combined into raw elevation, moisture and river values.
+// rowScratch holds kLayerCount * terrain.Width() floats of per-row noise output.
+void SampleTerrainRows(const WorldGenConfig& config, const NoiseGenerator& noise, const NoiseLayerInputs& in,
+                       int originX, int originY, WorldGrid<TerrainData>& terrain, int rowBegin, int rowEnd,
+                       float* rowScratch) {
+    const int width = terrain.Width();
+    float* continentRow = rowScratch;
+    float* detailRow = rowScratch + width;
+    float* mountainRow = rowScratch + 2 * width;
+    float* moistureRow = rowScratch + 3 * width;
+    float* riverRow = rowScratch + 4 * width;
 
-    for (int y = 0; y < WORLD_HEIGHT; ++y) {
-        for (int x = 0; x < WORLD_WIDTH; ++x) {
-            float nx = x / float(WORLD_WIDTH);
-            float ny = y / float(WORLD_HEIGHT);
+    for (int y = rowBegin; y < rowEnd; ++y) {
+        float ny = (originY + y) / float(WORLD_HEIGHT);
+        const int seed = static_cast<int>(config.seed);
+        noise.LayeredRow(in.continent, ny * 0.5f, width, config.continentOctaves, 0.6f, 0.5f, seed, continentRow);
+        noise.LayeredRow(in.detail, ny * 5.0f, width, config.terrainOctaves, 0.5f, 2.0f, seed + 1, detailRow);
+        noise.LayeredRow(in.mountain, ny * 3.0f, width, 4, 0.7f, 1.5f, seed + 4, mountainRow);
+        noise.LayeredRow(in.moisture, ny * 4.0f, width, 4, 0.5f, 2.0f, seed + 2, moistureRow);
+        noise.LayeredRow(in.river, ny * 8.0f, width, config.riverOctaves, 0.7f, 3.0f, seed + 3, riverRow);
 
-            float continentShape = LayeredNoise(nx * 0.5f, ny * 0.5f, CONTINENT_OCTAVES, 0.6f, 0.5f, 1);
-            float terrainDetail = LayeredNoise(nx * 5.0f, ny * 5.0f, TERRAIN_OCTAVES, 0.5f, 2.0f, 2);
-            float mountain = 1.0f - std::abs(LayeredNoise(nx * 3.0f, ny * 3.0f, 4, 0.7f, 1.5f, 5) * 2.0f - 1.0f);
+        for (int x = 0; x < width; ++x) {
+            float nx = (originX + x) / float(WORLD_WIDTH);
+
+            float continentShape = continentRow[x];
+            float terrainDetail = detailRow[x];
+            float mountain = 1.0f - std::abs(mountainRow[x] * 2.0f - 1.0f);
             mountain = std::pow(mountain, 3.0f);
-            float moisture = LayeredNoise(nx * 4.0f, ny * 4.0f, 4, 0.5f, 2.0f, 3);
-            float riverValue = LayeredNoise(nx * 8.0f, ny * 8.0f, RIVER_OCTAVES, 0.7f, 3.0f, 4);
+            float moisture = moistureRow[x];
+            float riverValue = riverRow[x];
 
             float dx = nx - 0.5f;
             float dy = ny - 0.5f;
@@ -102,19 +203,22 @@ std::vector<std::vector<Tile>> GenerateWorld() {
             float elevation = (continentShape * 0.5f + terrainDetail * 0.2f + mountain * 0.3f) * 100.0f;
             elevation = elevation * (islandFactor * 0.7f + 0.3f);
 
-            terrainData[y][x].elevation = elevation;
-            terrainData[y][x].moisture = moisture;
-            terrainData[y][x].riverValue = riverValue;
+            terrain(x, y).elevation = elevation;
+            terrain(x, y).moisture = moisture;
+            terrain(x, y).riverValue = riverValue;
         }
     }
+}
 
-    for (int y = 0; y < WORLD_HEIGHT; ++y) {
-        for (int x = 0; x < WORLD_WIDTH; ++x) {
-            TerrainData& data = terrainData[y][x];
-            if (data.riverValue > RIVER_THRESHOLD) {
-                float riverStrength = (data.riverValue - RIVER_THRESHOLD) / (1.0f - RIVER_THRESHOLD);
+// Stage 2: river and lake carving
+void CarveWaterRows(WorldGrid<TerrainData>& terrain, float riverThreshold, int rowBegin, int rowEnd) {
+    for (int y = rowBegin; y < rowEnd; ++y) {
+        for (int x = 0; x < terrain.Width(); ++x) {
+            TerrainData& data = terrain(x, y);
+            if (data.riverValue > riverThreshold) {
+                float riverStrength = (data.riverValue - riverThreshold) / (1.0f - riverThreshold);
                 data.elevation = std::min(data.elevation, WATER_LEVEL - riverStrength * 5.0f);
-                if (data.riverValue > RIVER_THRESHOLD - 0.1f && data.riverValue <= RIVER_THRESHOLD) {
+                if (data.riverValue > riverThreshold - 0.1f && data.riverValue <= riverThreshold) {
                     data.elevation = std::min(data.elevation, WATER_LEVEL - 1.0f);
                 }
             }
@@ -123,77 +227,287 @@ std::vector<std::vector<Tile>> GenerateWorld() {
             }
         }
     }
+}
 
-    std::vector<std::vector<float>> smoothedElevation(WORLD_HEIGHT, std::vector<float>(WORLD_WIDTH));
-    for (int y = 0; y < WORLD_HEIGHT; ++y) {
-        for (int x = 0; x < WORLD_WIDTH; ++x) {
-            float total = 0.0f;
-            int count = 0;
-            for (int ny = std::max(0, y-1); ny <= std::min(WORLD_HEIGHT-1, y+1); ++ny) {
-                for (int nx = std::max(0, x-1); nx <= std::min(WORLD_WIDTH-1, x+1); ++nx) {
-                    total += terrainData[ny][nx].elevation;
-                    count++;
-                }
-            }
-            if (terrainData[y][x].elevation <= WATER_LEVEL) {
-                smoothedElevation[y][x] = terrainData[y][x].elevation;
-            } else {
-                smoothedElevation[y][x] = (total / count) * 0.7f + terrainData[y][x].elevation * 0.3f;
-            }
+// Stage 3: 3x3 smoothing stencil for land, clamped at the grid edges.
+float SmoothedElevation(const WorldGrid<TerrainData>& terrain, int x, int y) {
+    const int width = terrain.Width();
+    const int height = terrain.Height();
+    float total = 0.0f;
+    int count = 0;
+    for (int ny = std::max(0, y-1); ny <= std::min(height-1, y+1); ++ny) {
+        for (int nx = std::max(0, x-1); nx <= std::min(width-1, x+1); ++nx) {
+            total += terrain(nx, ny).elevation;
+            count++;
         }
     }
+    if (terrain(x, y).elevation <= WATER_LEVEL) {
+        return terrain(x, y).elevation;
+    }
+    return (total / count) * 0.7f + terrain(x, y).elevation * 0.3f;
+}
 
-    for (int y = 0; y < WORLD_HEIGHT; ++y) {
-        for (int x = 0; x < WORLD_WIDTH; ++x) {
-            terrainData[y][x].elevation = smoothedElevation[y][x];
+// The smoothed elevation goes to its own plane rather than back into terrain, so the
+// stencil never reads a value it already overwrote and no copy-back pass is needed.
+// smoothed cell (x, y) holds terrain cell (x + haloX, y + haloY).
+void SmoothRows(const WorldGrid<TerrainData>& terrain, int haloX, int haloY, WorldGrid<float>& smoothed) {
+    for (int y = 0; y < smoothed.Height(); ++y) {
+        float* row = smoothed.Row(y);
+        for (int x = 0; x < smoothed.Width(); ++x) {
+            row[x] = SmoothedElevation(terrain, x + haloX, y + haloY);
         }
     }
+}
 
-    for (int y = 0; y < WORLD_HEIGHT; ++y) {
-        for (int x = 0; x < WORLD_WIDTH; ++x) {
-            TerrainData& data = terrainData[y][x];
-            data.biome = DetermineBiome(data.elevation, data.moisture);
-            Tile& tile = world[y][x];
-            tile.x = x;
-            tile.y = y;
-            tile.elevation = static_cast<int>(data.elevation);
-            const BiomeProperties& props = biomeProps.at(data.biome); // Use .at() for safety, or [] if sure key exists
-            tile.walkable = props.walkable;
-
-            // Debug coloring pattern from main.cpp
-            if ((tile.x + tile.y) % 10 == 0) {
-                tile.color = {255, 0, 0, 255};
-            } else if (tile.x == 0 || tile.y == 0 || tile.x == WORLD_WIDTH-1 || tile.y == WORLD_HEIGHT-1) {
-                tile.color = {255, 255, 0, 255};
-            } else if (tile.x == WORLD_WIDTH/2 || tile.y == WORLD_HEIGHT/2) {
-                tile.color = {0, 0, 255, 255};
-            } else {
-                std::random_device rd;
-                std::mt19937 gen(rd());
-                std::uniform_int_distribution<int> variation(-5, 5);
-                tile.color = {
-                    static_cast<Uint8>(std::clamp(props.baseColor.r + variation(gen), 0, 255)),
-                    static_cast<Uint8>(std::clamp(props.baseColor.g + variation(gen), 0, 255)),
-                    static_cast<Uint8>(std::clamp(props.baseColor.b + variation(gen), 0, 255)),
-                    255
-                };
+// Stage 4 for one tile: stores elevation, biome, walkability and color of tile (x, y),
+// which sits at world position (wx, wy); the color jitter is keyed by tiles.seed and the
+// debug lines placed by the tiles' world size
+void ClassifyTile(float elevation, BiomeType biome, int wx, int wy, WorldTiles& tiles, int x, int y) {
+    tiles.elevation(x, y) = static_cast<int16_t>(elevation);
+    tiles.biome(x, y) = biome;
+    tiles.SetWalkable(x, y, GetBiomeProperties(biome).walkable);
+
+    // Compact worlds derive the color from the biome when it is read
+    if (tiles.StoresColor()) {
+        tiles.color(x, y) = TileColor(biome, wx, wy, tiles.seed, tiles.worldWidth, tiles.worldHeight);
+    }
+}
+
+// Stage 4: biome, walkability and color for every smoothed cell, from the smoothed
+// elevation and the terrain moisture, counted into stats as they are stored. Cell (x, y)
+// reads terrain cell (x + haloX, y + haloY), is world tile (originX + x, originY + y) and
+// is stored in tiles at (tileX + x, tileY + y).
+void ClassifyRows(const WorldGrid<TerrainData>& terrain, int haloX, int haloY, const WorldGrid<float>& smoothed,
+                  int originX, int originY, WorldTiles& tiles, int tileX, int tileY, WorldStats& stats) {
+    for (int y = 0; y < smoothed.Height(); ++y) {
+        const TerrainData* terrainRow = terrain.Row(y + haloY) + haloX;
+        const float* elevationRow = smoothed.Row(y);
+        for (int x = 0; x < smoothed.Width(); ++x) {
+            const float elevation = elevationRow[x];
+            const BiomeType biome = DetermineBiome(elevation, terrainRow[x].moisture);
+            ClassifyTile(elevation, biome, originX + x, originY + y, tiles, tileX + x, tileY + y);
+            stats.Count(static_cast<int16_t>(elevation));
+        }
+    }
+}
+
+// Tiles per side of the blocks GenerateWorld runs through every stage at once. A block's
+// terrain, smoothed plane and tiles (about 100 KB with the halo) stay in L2 from the first
+// stage to the last instead of streaming the whole world through memory once per stage.
+constexpr int kGenerationBlockSize = 64;
+// Side by side blocks then set walkable bits in separate 64-bit words of a row
+static_assert(kGenerationBlockSize % 64 == 0, "blocks on different threads must not share walkable words");
+
+// Terrain cells sampled around a block on each side. Blocks inside the world see a one
+// tile halo; at the world edge the halo is zero, so the smoothing stencil clamps there
+// exactly as it would on one world-sized grid.
+struct BlockHalo {
+    int left = 1;
+    int top = 1;
+    int right = 1;
+    int bottom = 1;
+};
+
+// Adds the wall time since start to one stage, when timings are collected
+void AddStageTime(WorldGenTimings* timings, double WorldGenTimings::*stage,
+                  std::chrono::steady_clock::time_point& start) {
+    if (!timings) return;
+    const auto now = std::chrono::steady_clock::now();
+    timings->*stage += std::chrono::duration<double, std::milli>(now - start).count();
+    start = now;
+}
+
+// Every stage for the width x height tiles starting at world tile (originX, originY),
+// stored in tiles at (tileX, tileY). Intermediate buffers come from scratch, which the
+// caller resets afterwards.
+void GenerateBlock(const WorldGenConfig& config, const NoiseGenerator& noise, int originX, int originY,
+                   int width, int height,
+                   const BlockHalo& halo, ScratchArena& scratch, WorldTiles& tiles, int tileX, int tileY,
+                   WorldStats& stats, WorldGenTimings* timings) {
+    auto start = timings ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+    const int fieldX = originX - halo.left;
+    const int fieldY = originY - halo.top;
+    const int fieldWidth = width + halo.left + halo.right;
+    const int fieldHeight = height + halo.top + halo.bottom;
+    WorldGrid<TerrainData> terrain = scratch.Grid<TerrainData>(fieldWidth, fieldHeight);
+    WorldGrid<float> smoothed = scratch.Grid<float>(width, height);
+
+    const NoiseLayerInputs inputs = BuildLayerInputs(fieldX, fieldWidth, scratch.Allocate<float>(kLayerCount * fieldWidth));
+    SampleTerrainRows(config, noise, inputs, fieldX, fieldY, terrain, 0, fieldHeight,
+                      scratch.Allocate<float>(kLayerCount * fieldWidth));
+    AddStageTime(timings, &WorldGenTimings::noiseMs, start);
+    CarveWaterRows(terrain, config.riverThreshold, 0, fieldHeight);
+    AddStageTime(timings, &WorldGenTimings::carveMs, start);
+    SmoothRows(terrain, halo.left, halo.top, smoothed);
+    AddStageTime(timings, &WorldGenTimings::smoothMs, start);
+    WorldStats blockStats;
+    ClassifyRows(terrain, halo.left, halo.top, smoothed, originX, originY, tiles, tileX, tileY, blockStats);
+    AddStageTime(timings, &WorldGenTimings::classifyMs, start);
+
+    // Running totals over every world and chunk generated so far
+    static TelemetryCounter& waterCounter = RegisterCounter("worldgen.water_tiles");
+    static TelemetryCounter& landCounter = RegisterCounter("worldgen.land_tiles");
+    static TelemetryCounter& mountainCounter = RegisterCounter("worldgen.mountain_tiles");
+    waterCounter.Add(blockStats.waterTiles);
+    landCounter.Add(blockStats.landTiles);
+    mountainCounter.Add(blockStats.mountainTiles);
+    stats.Add(blockStats);
+}
+
+} // namespace
+
+// Region generation for chunks
+// The terrain grid carries a one-tile halo on every side, so the smoothing stencil sees the
+// same neighbours it would in one large world and adjacent regions join without seams.
+// Every intermediate buffer comes from scratch; tiles is the only memory written outside it.
+void GenerateRegion(const WorldGenConfig& config, const NoiseGenerator& noise, int originX, int originY,
+                    ScratchArena& scratch, WorldTiles& tiles) {
+    WorldStats stats;
+    tiles.seed = config.seed;
+    GenerateBlock(config, noise, originX, originY, tiles.Width(), tiles.Height(), BlockHalo{}, scratch, tiles,
+                  0, 0, stats, nullptr);
+}
+
+WorldTiles GenerateRegion(const WorldGenConfig& config, const NoiseGenerator& noise, int originX, int originY,
+                          int width, int height) {
+    WorldTiles tiles(width, height);
+    ScratchArena scratch;
+    GenerateRegion(config, noise, originX, originY, scratch, tiles);
+    return tiles;
+}
+
+// Unsmoothed terrain field for tile edits
+// Stages 1 and 2 only, so that RefreshTiles can redo stages 3 and 4 for any rectangle.
+WorldGrid<TerrainData> GenerateTerrainField(const WorldGenConfig& config, unsigned threadCount) {
+    const int width = config.width;
+    const int height = config.height;
+    WorldGrid<TerrainData> field(width, height, true);
+    ThreadPool pool(threadCount);
+    const NoiseGenerator noise = CreateWorldNoise(config);
+    std::vector<float> inputStorage(kLayerCount * width);
+    const NoiseLayerInputs inputs = BuildLayerInputs(0, width, inputStorage.data());
+    // Carving only reads the cell it writes, so each band carves its rows straight away
+    pool.ParallelFor(0, height, [&](int rowBegin, int rowEnd) {
+        std::vector<float> rowScratch(kLayerCount * width);
+        SampleTerrainRows(config, noise, inputs, 0, 0, field, rowBegin, rowEnd, rowScratch.data());
+        CarveWaterRows(field, config.riverThreshold, rowBegin, rowEnd);
+    });
+    return field;
+}
+
+void RefreshTiles(const WorldGrid<TerrainData>& field, const WorldGrid<BiomeType>* biomeOverride,
+                  WorldTiles& tiles, int minX, int minY, int maxX, int maxY) {
+    minX = std::max(minX, 0);
+    minY = std::max(minY, 0);
+    maxX = std::min(maxX, tiles.Width() - 1);
+    maxY = std::min(maxY, tiles.Height() - 1);
+    for (int y = minY; y <= maxY; ++y) {
+        for (int x = minX; x <= maxX; ++x) {
+            const float elevation = SmoothedElevation(field, x, y);
+            BiomeType biome = DetermineBiome(elevation, field(x, y).moisture);
+            if (biomeOverride && (*biomeOverride)(x, y) != BIOME_NOT_OVERRIDDEN) {
+                biome = (*biomeOverride)(x, y);
             }
+            ClassifyTile(elevation, biome, x, y, tiles, x, y);
         }
     }
+}
 
-    // Debug output from main.cpp (can be removed or made conditional later)
-    int waterTiles = 0, landTiles = 0, mountainTiles = 0;
-    for (int y = 0; y < WORLD_HEIGHT; y++) {
-        for (int x = 0; x < WORLD_WIDTH; x++) {
-            if (world[y][x].elevation < WATER_LEVEL) waterTiles++;
-            else if (world[y][x].elevation > MOUNTAIN_LEVEL) mountainTiles++;
-            else landTiles++;
+void WorldStats::Count(int16_t elevation) {
+    if (elevation < WATER_LEVEL) waterTiles++;
+    else if (elevation > MOUNTAIN_LEVEL) mountainTiles++;
+    else landTiles++;
+}
+
+void WorldStats::Add(const WorldStats& other) {
+    waterTiles += other.waterTiles;
+    landTiles += other.landTiles;
+    mountainTiles += other.mountainTiles;
+}
+
+WorldStats ComputeWorldStats(const WorldTiles& world) {
+    WorldStats stats;
+    for (int y = 0; y < world.Height(); ++y) {
+        const int16_t* row = world.elevation.Row(y);
+        for (int x = 0; x < world.Width(); ++x) {
+            stats.Count(row[x]);
         }
     }
-    std::cout << "World generation (from World.cpp) complete!" << std::endl;
-    std::cout << "Water tiles: " << waterTiles << " (" << (100.0f * waterTiles / (WORLD_WIDTH * WORLD_HEIGHT)) << "%)" << std::endl;
-    std::cout << "Land tiles: " << landTiles << " (" << (100.0f * landTiles / (WORLD_WIDTH * WORLD_HEIGHT)) << "%)" << std::endl;
-    std::cout << "Mountain tiles: " << mountainTiles << " (" << (100.0f * mountainTiles / (WORLD_WIDTH * WORLD_HEIGHT)) << "%)" << std::endl;
+    return stats;
+}
 
+// World generation function
+// The world is cut into kGenerationBlockSize blocks that run through every stage while
+// they are hot in cache, and the thread pool hands each thread a contiguous run of blocks.
+// Blocks sample their own halo instead of reading a neighbour's terrain, so they never
+// wait on each other and the result does not depend on the thread count.
+WorldTiles GenerateWorld(const WorldGenConfig& config, unsigned threadCount, TileStorage storage,
+                         WorldStats* stats, WorldGenTimings* timings) {
+    const int width = config.width;
+    const int height = config.height;
+    WorldTiles world(width, height, storage);
+    world.seed = config.seed;
+    world.worldWidth = width;
+    world.worldHeight = height;
+    const int blocksX = (width + kGenerationBlockSize - 1) / kGenerationBlockSize;
+    const int blocksY = (height + kGenerationBlockSize - 1) / kGenerationBlockSize;
+
+    ThreadPool pool(threadCount);
+    const NoiseGenerator noise = CreateWorldNoise(config);
+    std::mutex totalsMutex;
+    WorldStats totalStats;
+    WorldGenTimings slowestTimings;
+
+    pool.ParallelFor(0, blocksX * blocksY, [&](int blockBegin, int blockEnd) {
+        ScratchArena scratch;
+        WorldStats bandStats;
+        WorldGenTimings bandTimings;
+        for (int block = blockBegin; block < blockEnd; ++block) {
+            const int x0 = (block % blocksX) * kGenerationBlockSize;
+            const int y0 = (block / blocksX) * kGenerationBlockSize;
+            const int blockWidth = std::min(kGenerationBlockSize, width - x0);
+            const int blockHeight = std::min(kGenerationBlockSize, height - y0);
+            BlockHalo halo;
+            halo.left = x0 > 0 ? 1 : 0;
+            halo.top = y0 > 0 ? 1 : 0;
+            halo.right = x0 + blockWidth < width ? 1 : 0;
+            halo.bottom = y0 + blockHeight < height ? 1 : 0;
+            GenerateBlock(config, noise, x0, y0, blockWidth, blockHeight, halo, scratch, world, x0, y0, bandStats,
+                          timings ? &bandTimings : nullptr);
+            scratch.Reset();
+        }
+
+        std::lock_guard<std::mutex> lock(totalsMutex);
+        totalStats.Add(bandStats);
+        slowestTimings.noiseMs = std::max(slowestTimings.noiseMs, bandTimings.noiseMs);
+        slowestTimings.carveMs = std::max(slowestTimings.carveMs, bandTimings.carveMs);
+        slowestTimings.smoothMs = std::max(slowestTimings.smoothMs, bandTimings.smoothMs);
+        slowestTimings.classifyMs = std::max(slowestTimings.classifyMs, bandTimings.classifyMs);
+    });
+
+    if (stats) {
+        *stats = totalStats;
+    }
+    if (timings) {
+        // The slowest band bounds each stage's wall time. Bands are wall-clock timed, so a
+        // band that waited for a core counts that wait; an average over bands would
+        // understate stages whenever there are more threads than cores.
+        timings->noiseMs += slowestTimings.noiseMs;
+        timings->carveMs += slowestTimings.carveMs;
+        timings->smoothMs += slowestTimings.smoothMs;
+        timings->classifyMs += slowestTimings.classifyMs;
+    }
     return world;
 }
+
+WorldTiles GenerateWorld(unsigned threadCount, TileStorage storage, WorldStats* stats) {
+    return GenerateWorld(WorldGenConfig(), threadCount, storage, stats);
+}
+
+WorldTiles GenerateWorld(unsigned threadCount, int width, int height, WorldGenTimings* timings,
+                         TileStorage storage, WorldStats* stats) {
+    WorldGenConfig config;
+    config.width = width;
+    config.height = height;
+    return GenerateWorld(config, threadCount, storage, stats, timings);
+}
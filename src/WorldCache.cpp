@@ -0,0 +1,184 @@
+#include "WorldCache.h"
+#include "World.h" // For WORLD_GENERATOR_VERSION, WorldGenConfigHash
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define WORLD_CACHE_HAS_MMAP 1
+#endif
+
+static const char kWorldCacheMagic[8] = {'D', 'L', 'W', 'O', 'R', 'L', 'D', '\0'};
+static const uint32_t kByteOrderMark = 0x01020304u;
+
+static uint64_t AlignTo64(uint64_t offset) {
+    return (offset + 63) / 64 * 64;
+}
+
+// Header for a width x height world with every array offset filled in
+static WorldCacheHeader BuildHeader(const WorldGenConfig& config, TileStorage storage) {
+    const int width = config.width;
+    const int height = config.height;
+    WorldCacheHeader header{};
+    std::memcpy(header.magic, kWorldCacheMagic, sizeof(header.magic));
+    header.formatVersion = WORLD_CACHE_FORMAT_VERSION;
+    header.byteOrderMark = kByteOrderMark;
+    header.generatorVersion = WORLD_GENERATOR_VERSION;
+    header.seed = config.seed;
+    header.width = width;
+    header.height = height;
+    header.configHash = WorldGenConfigHash(config);
+
+    const uint64_t cells = static_cast<uint64_t>(width) * height;
+    const uint64_t walkableWords = static_cast<uint64_t>((width + 63) / 64) * height;
+    header.elevationOffset = AlignTo64(sizeof(WorldCacheHeader));
+    const uint64_t elevationEnd = header.elevationOffset + cells * sizeof(int16_t);
+    if (storage == TileStorage::Full) {
+        header.colorOffset = AlignTo64(elevationEnd);
+        header.walkableOffset = AlignTo64(header.colorOffset + cells * sizeof(SDL_Color));
+    } else {
+        header.colorOffset = 0;
+        header.walkableOffset = AlignTo64(elevationEnd);
+    }
+    header.biomeOffset = AlignTo64(header.walkableOffset + walkableWords * sizeof(uint64_t));
+    header.fileSize = header.biomeOffset + cells * sizeof(BiomeType);
+    return header;
+}
+
+// Writes the rows of a grid back to back, dropping any in-memory row padding
+template <typename T>
+static void WriteRows(std::ofstream& out, const WorldGrid<T>& grid) {
+    for (int y = 0; y < grid.Height(); ++y) {
+        out.write(reinterpret_cast<const char*>(grid.Row(y)), static_cast<std::streamsize>(grid.Width() * sizeof(T)));
+    }
+}
+
+static void PadTo(std::ofstream& out, uint64_t offset) {
+    static const char zeros[64] = {};
+    uint64_t position = static_cast<uint64_t>(out.tellp());
+    if (offset > position) {
+        out.write(zeros, static_cast<std::streamsize>(offset - position));
+    }
+}
+
+bool SaveWorldCache(const std::string& path, const WorldTiles& world, const WorldGenConfig& config) {
+    if (world.Width() != config.width || world.Height() != config.height) {
+        std::cerr << "World cache " << path << " not written: world size does not match its config" << std::endl;
+        return false;
+    }
+    const WorldCacheHeader header = BuildHeader(config, world.Storage());
+    const std::string tempPath = path + ".tmp";
+
+    std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "World cache: cannot write " << tempPath << std::endl;
+        return false;
+    }
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    PadTo(out, header.elevationOffset);
+    WriteRows(out, world.elevation);
+    if (world.StoresColor()) {
+        PadTo(out, header.colorOffset);
+        WriteRows(out, world.color);
+    }
+    PadTo(out, header.walkableOffset);
+    WriteRows(out, world.walkable);
+    PadTo(out, header.biomeOffset);
+    WriteRows(out, world.biome);
+    out.close();
+
+    // Rename into place so a crash mid-write never leaves a truncated cache behind
+    if (!out || std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::cerr << "World cache: failed to write " << path << std::endl;
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+// Checks a header read from a file of fileSize bytes against what the caller expects
+static bool HeaderMatches(const WorldCacheHeader& header, uint64_t fileSize, const WorldGenConfig& config,
+                          TileStorage storage) {
+    if (std::memcmp(header.magic, kWorldCacheMagic, sizeof(header.magic)) != 0) return false;
+    if (header.formatVersion != WORLD_CACHE_FORMAT_VERSION || header.byteOrderMark != kByteOrderMark) return false;
+    if (header.generatorVersion != WORLD_GENERATOR_VERSION || header.seed != config.seed) return false;
+    if (header.width != config.width || header.height != config.height) return false;
+    if (header.configHash != WorldGenConfigHash(config)) return false;
+
+    // Offsets must be exactly what this build would write, which also bounds them by the file
+    const WorldCacheHeader expected = BuildHeader(config, storage);
+    return header.elevationOffset == expected.elevationOffset && header.colorOffset == expected.colorOffset &&
+           header.walkableOffset == expected.walkableOffset && header.biomeOffset == expected.biomeOffset &&
+           header.fileSize == expected.fileSize && fileSize >= expected.fileSize;
+}
+
+// Builds a WorldTiles whose grids are views into a buffer laid out as described by header
+static WorldTiles ViewWorld(unsigned char* base, const WorldCacheHeader& header, std::shared_ptr<const void> backing) {
+    const int width = header.width;
+    const int height = header.height;
+    WorldTiles world;
+    world.elevation = WorldGrid<int16_t>::View(reinterpret_cast<int16_t*>(base + header.elevationOffset), width, height, width);
+    if (header.colorOffset != 0) {
+        world.color = WorldGrid<SDL_Color>::View(reinterpret_cast<SDL_Color*>(base + header.colorOffset), width, height, width);
+    }
+    world.walkable = WorldGrid<uint64_t>::View(reinterpret_cast<uint64_t*>(base + header.walkableOffset),
+                                               (width + 63) / 64, height, (width + 63) / 64);
+    world.biome = WorldGrid<BiomeType>::View(reinterpret_cast<BiomeType*>(base + header.biomeOffset), width, height, width);
+    world.seed = header.seed;
+    world.worldWidth = header.width;
+    world.worldHeight = header.height;
+    world.backing = std::move(backing);
+    return world;
+}
+
+bool LoadWorldCache(const std::string& path, const WorldGenConfig& config, TileStorage storage, WorldTiles& out) {
+#ifdef WORLD_CACHE_HAS_MMAP
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    WorldCacheHeader header;
+    if (fstat(fd, &info) != 0 || static_cast<uint64_t>(info.st_size) < sizeof(header) ||
+        pread(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)) ||
+        !HeaderMatches(header, static_cast<uint64_t>(info.st_size), config, storage)) {
+        close(fd);
+        return false;
+    }
+
+    // Private writable mapping: pages fault in from the file on first touch, and any later
+    // in-memory edit gets its own copy instead of writing through to the cache
+    const size_t length = static_cast<size_t>(header.fileSize);
+    void* mapping = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) return false;
+
+    std::shared_ptr<const void> backing(mapping, [length](const void* p) { munmap(const_cast<void*>(p), length); });
+    out = ViewWorld(static_cast<unsigned char*>(mapping), header, std::move(backing));
+    return true;
+#else
+    // No mmap on this platform: read the whole file into one buffer and view that instead
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) return false;
+    const uint64_t fileSize = static_cast<uint64_t>(in.tellg());
+    WorldCacheHeader header;
+    in.seekg(0);
+    if (fileSize < sizeof(header) || !in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        !HeaderMatches(header, fileSize, config, storage)) {
+        return false;
+    }
+    auto buffer = std::make_shared<std::vector<uint64_t>>((header.fileSize + 7) / 8);
+    in.seekg(0);
+    if (!in.read(reinterpret_cast<char*>(buffer->data()), static_cast<std::streamsize>(header.fileSize))) {
+        return false;
+    }
+    out = ViewWorld(reinterpret_cast<unsigned char*>(buffer->data()), header, buffer);
+    return true;
+#endif
+}
@@ -0,0 +1,74 @@
+#include "WorldEdit.h"
+#include <algorithm>
+#include <cmath>
+#include "World.h"
+
+WorldEditor::WorldEditor(WorldTiles& world, const WorldGenConfig& config, unsigned threadCount)
+    : world(world), config(config), threadCount(threadCount) {}
+
+void WorldEditor::EnsureField() {
+    if (field.Width() == world.Width() && field.Height() == world.Height()) return;
+    WorldGenConfig fieldConfig = config;
+    fieldConfig.width = world.Width();
+    fieldConfig.height = world.Height();
+    field = GenerateTerrainField(fieldConfig, threadCount);
+    biomeOverride = WorldGrid<BiomeType>(world.Width(), world.Height(), BIOME_NOT_OVERRIDDEN);
+}
+
+TileEdit WorldEditor::Refresh(const TileRect& changed) {
+    TileEdit edit;
+    edit.tiles = {std::max(changed.minX - 1, 0), std::max(changed.minY - 1, 0),
+                  std::min(changed.maxX + 1, world.Width() - 1), std::min(changed.maxY + 1, world.Height() - 1)};
+    if (edit.tiles.Empty()) return edit;
+
+    RefreshTiles(field, &biomeOverride, world, edit.tiles.minX, edit.tiles.minY, edit.tiles.maxX, edit.tiles.maxY);
+
+    edit.elevation.min = edit.elevation.max = world.elevation(edit.tiles.minX, edit.tiles.minY);
+    for (int y = edit.tiles.minY; y <= edit.tiles.maxY; ++y) {
+        for (int x = edit.tiles.minX; x <= edit.tiles.maxX; ++x) {
+            edit.elevation.min = std::min<int>(edit.elevation.min, world.elevation(x, y));
+            edit.elevation.max = std::max<int>(edit.elevation.max, world.elevation(x, y));
+        }
+    }
+    return edit;
+}
+
+TileEdit WorldEditor::SetElevation(int x, int y, float elevation) {
+    if (!world.InBounds(x, y)) return {};
+    EnsureField();
+    field(x, y).elevation = elevation;
+    return Refresh({x, y, x, y});
+}
+
+TileEdit WorldEditor::SetBiome(int x, int y, BiomeType biome) {
+    if (!world.InBounds(x, y)) return {};
+    EnsureField();
+    biomeOverride(x, y) = biome;
+    return Refresh({x, y, x, y});
+}
+
+TileEdit WorldEditor::ApplyBrush(const Brush& brush) {
+    const int radius = std::max(brush.radius, 1);
+    const TileRect changed = {std::max(brush.centerX - radius, 0), std::max(brush.centerY - radius, 0),
+                              std::min(brush.centerX + radius, world.Width() - 1),
+                              std::min(brush.centerY + radius, world.Height() - 1)};
+    if (changed.Empty()) return {};
+    EnsureField();
+
+    for (int y = changed.minY; y <= changed.maxY; ++y) {
+        for (int x = changed.minX; x <= changed.maxX; ++x) {
+            const float distance = std::hypot(static_cast<float>(x - brush.centerX), static_cast<float>(y - brush.centerY));
+            const float weight = 1.0f - distance / radius;
+            if (weight <= 0.0f) continue;
+
+            float& elevation = field(x, y).elevation;
+            switch (brush.op) {
+                case BrushOp::Raise:   elevation += brush.amount * weight; break;
+                case BrushOp::Lower:   elevation -= brush.amount * weight; break;
+                case BrushOp::Flatten: elevation += (brush.amount - elevation) * weight; break;
+                case BrushOp::SetBiome: biomeOverride(x, y) = brush.biome; break;
+            }
+        }
+    }
+    return Refresh(changed);
+}
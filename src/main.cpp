@@ -3,8 +3,13 @@
 #include <vector>
 #include <cmath>
 #include <random>
+#include <cstdio>  // For std::sscanf
+#include <cstdlib> // For std::atoi, std::strtoul, std::strtof
 #include <algorithm>
+#include <fstream>
 #include <map>
+#include <string>
+#include <thread>
 
 #include "../include/GameConstants.h"
 #include "../include/Player.h"
@@ -13,6 +18,70 @@
 #include "../include/Noise.h"
 #include "../include/World.h"
 #include "../include/Renderer.h"
+#include "../include/Visibility.h"
+#include "../include/TerrainSource.h"
+#include "../include/ChunkManager.h"
+#include "../include/WorldCache.h"
+#include "../include/Profiler.h"
+#include "../include/ChunkTextureCache.h"
+#include "../include/FixedTimestep.h"
+#include "../include/WorldEdit.h"
+#include "../include/TerrainLod.h"
+#include "../include/Telemetry.h"
+#include "../include/FrameCache.h"
+#include "../include/Entities.h"
+#include "../include/TerrainQuery.h"
+#include "../include/ThreadPool.h"
+#include "../include/InputReplay.h"
+
+// Fixed worlds are cached here between runs
+static const char* const WORLD_CACHE_PATH = "world_cache.bin";
+// F4 writes the profiler history here
+static const char* const PROFILE_CSV_PATH = "profile_frames.csv";
+
+// True when the last simulation step left the player exactly where it was, with nothing
+// (a jump, momentum) that would move it on the next step
+static bool PlayerAtRest(const Player& previous, const Player& current) {
+    return previous.x == current.x && previous.y == current.y && previous.elevation == current.elevation &&
+           current.velocityX == 0 && current.velocityY == 0 && current.velocityZ == 0 && !current.isJumping;
+}
+
+// Scatters count wanderers within radius tiles of the player, each walking in a fixed
+// random direction. The generator is seeded from the world seed, so every run of a world
+// spawns the same ones.
+static void SpawnWanderers(EntityStore& entities, int count, const Player& player, const TerrainSource& terrain,
+                           uint32_t seed) {
+    const float radius = 24.0f;
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> offset(-radius, radius);
+    std::uniform_real_distribution<float> heading(0.0f, 6.2831853f);
+    std::uniform_int_distribution<int> channel(64, 255);
+    const TileBounds bounds = terrain.Bounds();
+    for (int i = 0; i < count; ++i) {
+        float x = player.x + offset(rng);
+        float y = player.y + offset(rng);
+        if (bounds.bounded) {
+            x = std::max(bounds.minX + 1.0f, std::min(x, static_cast<float>(bounds.maxX - 2)));
+            y = std::max(bounds.minY + 1.0f, std::min(y, static_cast<float>(bounds.maxY - 2)));
+        }
+        const float angle = heading(rng);
+        const SDL_Color color = {static_cast<Uint8>(channel(rng)), static_cast<Uint8>(channel(rng)),
+                                 static_cast<Uint8>(channel(rng)), 255};
+        entities.Add(x, y, HeightAt(terrain, x, y), std::cos(angle) * ENTITY_WANDER_SPEED,
+                     std::sin(angle) * ENTITY_WANDER_SPEED, color);
+    }
+}
+
+// Parses "WIDTHxHEIGHT", or a single number for a square world
+static bool ParseWorldSize(const char* text, int& width, int& height) {
+    char separator = 0;
+    const int fields = std::sscanf(text, "%d%c%d", &width, &separator, &height);
+    if (fields == 1) {
+        height = width;
+        return true;
+    }
+    return fields == 3 && separator == 'x';
+}
 
 // Camera global variables - these might be better inside the Camera struct or a GameState class later
 float cameraX_global = 0; // Renamed to avoid conflict if Camera struct members are named x,y
@@ -20,6 +89,87 @@ float cameraY_global = 0;
 
 // Update main game loop
 int main(int argc, char* argv[]) {
+    // --stream replaces the fixed --size grid with an unbounded world
+    // generated in chunks around the player
+    // --no-vsync presents as fast as possible; simulation speed is unaffected
+    // --compact keeps the fixed world without its color array and decodes colors on use
+    // --log-level debug|info|warning|error|off sets what the telemetry logger prints
+    // --no-frame-skip redraws every frame even when nothing on screen changed
+    // --entities N spawns N wandering NPCs around the player
+    // --seed N, --size WIDTHxHEIGHT, --octaves CONTINENT,TERRAIN,RIVER and --river-threshold F
+    // set the WorldGenConfig; the same config always generates the same world
+    // --record PATH saves the keyboard input of the run when it ends
+    // --replay PATH plays a recording back in place of the keyboard, with vsync and frame
+    // skipping off so every frame is drawn, then prints frame time percentiles per phase
+    // (to --report PATH if given). The fixed world replays exactly; a streamed world can
+    // differ while chunks finish loading at different times.
+    // --headless keeps the window hidden, e.g. for replays on a build machine
+    bool streamWorld = false;
+    bool vsync = true;
+    bool frameSkip = true;
+    TileStorage worldStorage = TileStorage::Full;
+    LogLevel logLevel = LogLevel::Info;
+    int entityCount = 0;
+    WorldGenConfig worldConfig;
+    bool headless = false;
+    std::string recordPath;
+    std::string replayPath;
+    std::string reportPath;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--stream") streamWorld = true;
+        else if (std::string(argv[i]) == "--no-vsync") vsync = false;
+        else if (std::string(argv[i]) == "--compact") worldStorage = TileStorage::Compact;
+        else if (std::string(argv[i]) == "--no-frame-skip") frameSkip = false;
+        else if (std::string(argv[i]) == "--entities" && i + 1 < argc) entityCount = std::max(0, std::atoi(argv[++i]));
+        else if (std::string(argv[i]) == "--seed" && i + 1 < argc) {
+            worldConfig.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (std::string(argv[i]) == "--size" && i + 1 < argc) {
+            if (!ParseWorldSize(argv[++i], worldConfig.width, worldConfig.height)) {
+                std::cerr << "Invalid world size " << argv[i] << "; expected WIDTHxHEIGHT" << std::endl;
+                return 1;
+            }
+        }
+        else if (std::string(argv[i]) == "--octaves" && i + 1 < argc) {
+            if (std::sscanf(argv[++i], "%d,%d,%d", &worldConfig.continentOctaves, &worldConfig.terrainOctaves,
+                            &worldConfig.riverOctaves) != 3) {
+                std::cerr << "Invalid octaves " << argv[i] << "; expected CONTINENT,TERRAIN,RIVER" << std::endl;
+                return 1;
+            }
+        }
+        else if (std::string(argv[i]) == "--river-threshold" && i + 1 < argc) {
+            worldConfig.riverThreshold = std::strtof(argv[++i], nullptr);
+        }
+        else if (std::string(argv[i]) == "--record" && i + 1 < argc) recordPath = argv[++i];
+        else if (std::string(argv[i]) == "--replay" && i + 1 < argc) replayPath = argv[++i];
+        else if (std::string(argv[i]) == "--report" && i + 1 < argc) reportPath = argv[++i];
+        else if (std::string(argv[i]) == "--headless") headless = true;
+        else if (std::string(argv[i]) == "--log-level" && i + 1 < argc) {
+            if (!ParseLogLevel(argv[++i], logLevel)) {
+                std::cerr << "Unknown log level " << argv[i] << "; using info" << std::endl;
+            }
+        }
+    }
+
+    if (!worldConfig.Validate()) {
+        return 1;
+    }
+    if (!recordPath.empty() && !replayPath.empty()) {
+        std::cerr << "--record and --replay cannot be combined" << std::endl;
+        return 1;
+    }
+    const bool recordingInput = !recordPath.empty();
+    const bool replaying = !replayPath.empty();
+    InputRecording replayInput;
+    if (replaying) {
+        if (!replayInput.Load(replayPath)) {
+            return 1;
+        }
+        // Frame times are measured, not paced: present as fast as possible and draw every frame
+        vsync = false;
+        frameSkip = false;
+    }
+
     if (SDL_Init(SDL_INIT_VIDEO) < 0) {
         std::cerr << "SDL initialization failed: " << SDL_GetError() << std::endl;
         return 1;
@@ -29,7 +179,7 @@ int main(int argc, char* argv[]) {
         "2.5D Lands - Debug Mode",
         SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
         SCREEN_WIDTH, SCREEN_HEIGHT,
-        SDL_WINDOW_SHOWN
+        headless ? SDL_WINDOW_HIDDEN : SDL_WINDOW_SHOWN
     );
 
     if (!window) {
@@ -40,7 +190,7 @@ int main(int argc, char* argv[]) {
 
     SDL_Renderer* renderer = SDL_CreateRenderer(
         window, -1,
-        SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC
+        SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE | (vsync ? SDL_RENDERER_PRESENTVSYNC : 0u)
     );
 
     if (!renderer) {
@@ -51,27 +201,55 @@ int main(int argc, char* argv[]) {
     }
 
     std::cout << "Generating world..." << std::endl;
-    std::cout << "World size: " << WORLD_WIDTH << "x" << WORLD_HEIGHT << std::endl;
+    if (streamWorld) {
+        std::cout << "World size: unbounded (" << CHUNK_SIZE << "x" << CHUNK_SIZE << " chunks, load radius "
+                  << CHUNK_LOAD_RADIUS << ")" << std::endl;
+    } else {
+        std::cout << "World size: " << worldConfig.width << "x" << worldConfig.height << std::endl;
+    }
+    std::cout << "World seed: " << worldConfig.seed << " (config hash " << std::hex << WorldGenConfigHash(worldConfig)
+              << std::dec << ")" << std::endl;
     std::cout << "Screen size: " << SCREEN_WIDTH << "x" << SCREEN_HEIGHT << std::endl;
     std::cout << "Tile dimensions: " << TILE_WIDTH << "x" << TILE_HEIGHT << " (depth: " << TILE_DEPTH << ")" << std::endl;
 
     // Generate a smaller world for debugging if needed
-    auto world = GenerateWorld();
-
-    // Output terrain statistics
-    int waterTiles = 0, landTiles = 0, mountainTiles = 0;
-    for (int y = 0; y < WORLD_HEIGHT; y++) {
-        for (int x = 0; x < WORLD_WIDTH; x++) {
-            if (world[y][x].elevation < WATER_LEVEL) waterTiles++;
-            else if (world[y][x].elevation > MOUNTAIN_LEVEL) mountainTiles++;
-            else landTiles++;
+    // Use every hardware thread; the result is the same as a single-threaded run
+    // A streamed world generates nothing up front; chunks appear as the player moves
+    // A matching cache file from an earlier run is mapped instead of regenerating
+    WorldTiles world;
+    bool worldFromCache = false;
+    if (!streamWorld) {
+        // Generation counts the tiles as it goes; only a cached world needs a separate pass
+        WorldStats stats;
+        worldFromCache = LoadWorldCache(WORLD_CACHE_PATH, worldConfig, worldStorage, world);
+        if (worldFromCache) {
+            std::cout << "Loaded world from " << WORLD_CACHE_PATH << std::endl;
+            stats = ComputeWorldStats(world);
+        } else {
+            world = GenerateWorld(worldConfig, 0, worldStorage, &stats);
+            SaveWorldCache(WORLD_CACHE_PATH, world, worldConfig);
         }
+        // Equal for every run, machine and thread count with this config
+        std::cout << "World hash: " << std::hex << WorldContentHash(world) << std::dec << std::endl;
+
+        // Terrain statistics are printed by the telemetry logger once it starts
+        [[maybe_unused]] const float percent = 100.0f / (static_cast<float>(worldConfig.width) * worldConfig.height);
+        TELEMETRY_LOG(LogLevel::Info, "World generation complete: water %d (%.1f%%), land %d (%.1f%%), mountain %d (%.1f%%)",
+                      stats.waterTiles, stats.waterTiles * percent, stats.landTiles, stats.landTiles * percent,
+                      stats.mountainTiles, stats.mountainTiles * percent);
     }
 
-    std::cout << "World generation complete!" << std::endl;
-    std::cout << "Water tiles: " << waterTiles << " (" << (100.0f * waterTiles / (WORLD_WIDTH * WORLD_HEIGHT)) << "%)" << std::endl;
-    std::cout << "Land tiles: " << landTiles << " (" << (100.0f * landTiles / (WORLD_WIDTH * WORLD_HEIGHT)) << "%)" << std::endl;
-    std::cout << "Mountain tiles: " << mountainTiles << " (" << (100.0f * mountainTiles / (WORLD_WIDTH * WORLD_HEIGHT)) << "%)" << std::endl;
+    // Movement and rendering only see the world through the chunk-aware TerrainSource
+    WorldTilesSource fixedTerrain(world);
+    // Chunks are generated on background workers so crossing chunk borders never stalls a frame
+    ChunkManager chunkTerrain(CHUNK_MEMORY_BUDGET, CHUNK_LOAD_RADIUS,
+                              streamWorld ? std::max(2u, std::thread::hardware_concurrency()) - 1 : 0, worldConfig);
+    TerrainSource& terrain = streamWorld ? static_cast<TerrainSource&>(chunkTerrain) : fixedTerrain;
+    // E/Q raise and lower the fixed world under the player; streamed chunks are not editable
+    WorldEditor worldEditor(world, worldConfig);
+    // Aggregated levels for zoomed-out views; a streamed world leaves world empty, so only
+    // level 0 exists there
+    TerrainLod terrainLod(world);
 
     // Simple player initialization at a fixed position for debugging
     Player player;
@@ -83,11 +261,18 @@ int main(int argc, char* argv[]) {
     Camera camera;
     camera.x = 0;
     camera.y = 0;
+    camera.snap(player); // Start centered instead of easing in from the origin
+
+    // NPCs share the player's physics but move on their own; their update is spread over
+    // every core once there are enough of them
+    EntityStore entities;
+    SpawnWanderers(entities, entityCount, player, terrain, worldConfig.seed);
+    ThreadPool entityPool(entityCount > 0 ? 0 : 1);
+    EntityBatch entityBatch;
 
     // Print initial positions
     std::cout << "Initial player position: (" << player.x << ", " << player.y << ", " << player.elevation << ")" << std::endl;
 
-    Uint32 lastTime = SDL_GetTicks();
     bool running = true;
     SDL_Event event;
 
@@ -99,118 +284,329 @@ int main(int argc, char* argv[]) {
               << "D - Move right (east)\n"
               << "Arrow Keys - Alternative movement\n"
               << "SPACE - Jump\n"
-              << "F3 - Toggle debug mode\n"
+              << "F3 - Toggle debug mode and frame profiler\n"
+              << "F4 - Dump profiler history to " << PROFILE_CSV_PATH << "\n"
               << "R - Reset player position\n"
               << "T - Test tile rendering\n"
+              << "C - Toggle pre-rendered terrain textures\n"
+              << "E/Q - Raise/lower terrain under the player (fixed world only)\n"
+              << "+/- - Zoom in/out\n"
               << "ESC - Quit game\n" << std::endl;
 
     bool debugMode = true; // Start with debug mode enabled for visibility
 
-    while (running) {
-        Uint32 currentTime = SDL_GetTicks();
-        float deltaTime = (currentTime - lastTime) / 1000.0f;
-        lastTime = currentTime;
+    // Reused every frame so the vertex/index buffers keep their capacity
+    TileBatch tileBatch;
+    VisibleTileRange visibleTiles;
+    FrameProfiler profiler;
+
+    // Simulation runs in fixed steps; rendering blends the last two steps
+    FixedTimestep simulationClock(SIMULATION_TIMESTEP, MAX_SIMULATION_STEPS);
+    Player previousPlayer = player;
+
+    // Static terrain is baked into textures once and copied to the screen every frame
+    ChunkTextureCache chunkTextures(renderer);
+    bool useChunkTextures = chunkTextures.Supported();
+    if (!useChunkTextures) {
+        std::cout << "Render targets unsupported; drawing every tile each frame" << std::endl;
+    }
+
+    // Frames that would look like the last one drawn are not drawn at all, and while the
+    // player stands still the loop sleeps until input arrives. When only the player moved,
+    // the terrain captured by the last full frame is copied back instead of redrawn.
+    // Edits and streamed chunks bump terrainRevision so the terrain is drawn again.
+    TerrainFrameCache terrainFrame(renderer);
+    FrameState drawnFrame;
+    bool hasDrawnFrame = false; // Cleared whenever the screen contents may have been lost
+    uint64_t terrainRevision = 0;
+    const SDL_Color background = {25, 25, 35, 255}; // Dark blue-gray
+
+    // Per-frame state goes to gauges that the logger thread prints once per flush interval,
+    // so nothing in the loop below writes to the console itself
+    TelemetryGauge& frameMsGauge = RegisterGauge("frame.ms", LogLevel::Info);
+    TelemetryGauge& tilesDrawnGauge = RegisterGauge("frame.tiles_drawn", LogLevel::Info);
+    TelemetryGauge& cameraXGauge = RegisterGauge("camera.x");
+    TelemetryGauge& cameraYGauge = RegisterGauge("camera.y");
+    TelemetryGauge& playerXGauge = RegisterGauge("player.x");
+    TelemetryGauge& playerYGauge = RegisterGauge("player.y");
+    TelemetryGauge& playerElevationGauge = RegisterGauge("player.elevation");
+    TelemetryGauge& entitiesDrawnGauge = RegisterGauge("entities.drawn");
+    TelemetryCounter& skippedFramesCounter = RegisterCounter("frame.skipped", LogLevel::Info);
+    TelemetryCounter& cachedFramesCounter = RegisterCounter("frame.terrain_cached");
+    // Input of the frame being recorded, and the replay's position and frame timings
+    InputRecording recordedInput;
+    InputFrame inputFrame;
+    size_t replayFrame = 0;
+    std::vector<Uint8> replayKeyState;
+    std::vector<FrameSample> replayTimings;
+    replayTimings.reserve(replayInput.FrameCount());
+    if (replaying) {
+        std::cout << "Replaying " << replayInput.FrameCount() << " frames from " << replayPath << std::endl;
+    }
+
+    // Started after the startup text so the logger thread never interleaves with it
+    StartTelemetry(logLevel);
 
-        while (SDL_PollEvent(&event)) {
-            if (event.type == SDL_QUIT) {
-                running = false;
+    // Key presses, live or replayed
+    auto handleKeyDown = [&](SDL_Keycode key) {
+        if (key == SDLK_ESCAPE) {
+            running = false;
+        }
+        else if (key == SDLK_F3) {
+            debugMode = !debugMode;
+            TELEMETRY_LOG(LogLevel::Info, "Debug mode: %s", debugMode ? "ON" : "OFF");
+        }
+        else if (key == SDLK_c && chunkTextures.Supported()) {
+            useChunkTextures = !useChunkTextures;
+            TELEMETRY_LOG(LogLevel::Info, "Pre-rendered terrain: %s", useChunkTextures ? "ON" : "OFF");
+        }
+        else if (key == SDLK_F4) {
+            if (profiler.DumpCsv(PROFILE_CSV_PATH)) {
+                TELEMETRY_LOG(LogLevel::Info, "Wrote %d frames to %s", profiler.FrameCount(), PROFILE_CSV_PATH);
+            } else {
+                std::cerr << "Could not write " << PROFILE_CSV_PATH << std::endl;
             }
-            else if (event.type == SDL_KEYDOWN) {
-                if (event.key.keysym.sym == SDLK_ESCAPE) {
+        }
+        else if ((key == SDLK_e || key == SDLK_q) && !streamWorld) {
+            Brush brush;
+            brush.centerX = static_cast<int>(std::floor(player.x));
+            brush.centerY = static_cast<int>(std::floor(player.y));
+            brush.radius = 3;
+            brush.op = key == SDLK_e ? BrushOp::Raise : BrushOp::Lower;
+            brush.amount = 4.0f;
+            TileEdit edit = worldEditor.ApplyBrush(brush);
+            if (!edit.tiles.Empty()) {
+                chunkTextures.Invalidate(edit.tiles.minX, edit.tiles.minY, edit.tiles.maxX, edit.tiles.maxY);
+                fixedTerrain.IncludeElevations(edit.elevation);
+                terrainLod.Update(edit.tiles.minX, edit.tiles.minY, edit.tiles.maxX, edit.tiles.maxY);
+                terrainRevision++;
+            }
+        }
+        else if (key == SDLK_EQUALS || key == SDLK_PLUS || key == SDLK_MINUS) {
+            const float minZoom = streamWorld ? STREAMED_MIN_ZOOM : MIN_ZOOM;
+            const float factor = key == SDLK_MINUS ? 1.0f / ZOOM_STEP : ZOOM_STEP;
+            camera.setZoom(std::clamp(camera.zoom * factor, minZoom, MAX_ZOOM), player.elevation);
+        }
+        // Alternative movement with arrow keys for testing
+        else if (key == SDLK_UP) {
+            player.y -= 1.0f;
+            TELEMETRY_LOG(LogLevel::Debug, "Arrow UP pressed: Player at (%.1f, %.1f)", player.x, player.y);
+        }
+        else if (key == SDLK_DOWN) {
+            player.y += 1.0f;
+            TELEMETRY_LOG(LogLevel::Debug, "Arrow DOWN pressed: Player at (%.1f, %.1f)", player.x, player.y);
+        }
+        else if (key == SDLK_LEFT) {
+            player.x -= 1.0f;
+            TELEMETRY_LOG(LogLevel::Debug, "Arrow LEFT pressed: Player at (%.1f, %.1f)", player.x, player.y);
+        }
+        else if (key == SDLK_RIGHT) {
+            player.x += 1.0f;
+            TELEMETRY_LOG(LogLevel::Debug, "Arrow RIGHT pressed: Player at (%.1f, %.1f)", player.x, player.y);
+        }
+        // Reset player position
+        else if (key == SDLK_r) {
+            player.x = 10.0f;
+            player.y = 10.0f;
+            player.elevation = 30.0f;
+            previousPlayer = player; // Snap instead of blending from the old position
+            camera.snap(player);
+            TELEMETRY_LOG(LogLevel::Info, "Player position reset to (10, 10, 30)");
+        }
+        // Testing key for direct tile rendering
+        else if (key == SDLK_t) {
+            // Draw a test tile in the center of the screen
+            Tile testTile;
+            testTile.x = 0;
+            testTile.y = 0;
+            testTile.elevation = 0;
+            testTile.color = {255, 0, 0, 255};
+
+            // Camera offset that puts world (0, 0) at the screen center
+            Camera testCam;
+            testCam.x = -SCREEN_WIDTH / 2.0f;
+            testCam.y = -SCREEN_HEIGHT / 2.0f;
+
+            TELEMETRY_LOG(LogLevel::Debug, "Drawing test tile at center");
+            RenderTile(renderer, testTile, testCam);
+            SDL_RenderPresent(renderer);
+            SDL_Delay(1000); // Pause to see the test tile
+            hasDrawnFrame = false;
+        }
+    };
+
+    while (running) {
+        // A replay ends with its last recorded frame
+        if (replaying && replayFrame == replayInput.FrameCount()) break;
+        profiler.BeginFrame();
+
+        {
+            ScopedPhaseTimer eventTimer(profiler, ProfilePhase::Events);
+            while (SDL_PollEvent(&event)) {
+                if (event.type == SDL_QUIT) {
                     running = false;
                 }
-                else if (event.key.keysym.sym == SDLK_F3) {
-                    debugMode = !debugMode;
-                    std::cout << "Debug mode: " << (debugMode ? "ON" : "OFF") << std::endl;
-                }
-                // Alternative movement with arrow keys for testing
-                else if (event.key.keysym.sym == SDLK_UP) {
-                    player.y -= 1.0f;
-                    std::cout << "Arrow UP pressed: Player at (" << player.x << ", " << player.y << ")" << std::endl;
-                }
-                else if (event.key.keysym.sym == SDLK_DOWN) {
-                    player.y += 1.0f;
-                    std::cout << "Arrow DOWN pressed: Player at (" << player.x << ", " << player.y << ")" << std::endl;
+                else if (event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET) {
+                    // Target texture contents are lost; bake everything again
+                    chunkTextures.InvalidateAll();
+                    terrainFrame.Invalidate();
+                    hasDrawnFrame = false;
                 }
-                else if (event.key.keysym.sym == SDLK_LEFT) {
-                    player.x -= 1.0f;
-                    std::cout << "Arrow LEFT pressed: Player at (" << player.x << ", " << player.y << ")" << std::endl;
+                else if (event.type == SDL_WINDOWEVENT) {
+                    // Exposed, resized, restored: the window may no longer show the last frame
+                    hasDrawnFrame = false;
                 }
-                else if (event.key.keysym.sym == SDLK_RIGHT) {
-                    player.x += 1.0f;
-                    std::cout << "Arrow RIGHT pressed: Player at (" << player.x << ", " << player.y << ")" << std::endl;
-                }
-                // Reset player position
-                else if (event.key.keysym.sym == SDLK_r) {
-                    player.x = 10.0f;
-                    player.y = 10.0f;
-                    player.elevation = 30.0f;
-                    std::cout << "Player position reset to (10, 10, 30)" << std::endl;
-                }
-                // Testing key for direct tile rendering
-                else if (event.key.keysym.sym == SDLK_t) {
-                    // Draw a test tile in the center of the screen
-                    Tile testTile;
-                    testTile.x = 0;
-                    testTile.y = 0;
-                    testTile.elevation = 0;
-                    testTile.color = {255, 0, 0, 255};
-
-                    Camera testCam;
-                    testCam.x = 0;
-                    testCam.y = 0;
-
-                    std::cout << "Drawing test tile at center" << std::endl;
-                    RenderTile(renderer, testTile, testCam, player);
-                    SDL_RenderPresent(renderer);
-                    SDL_Delay(1000); // Pause to see the test tile
+                else if (event.type == SDL_KEYDOWN) {
+                    // A replay only takes recorded key presses; ESC still stops it
+                    if (replaying && event.key.keysym.sym != SDLK_ESCAPE) continue;
+                    if (recordingInput) inputFrame.pressed.push_back(event.key.keysym.sym);
+                    handleKeyDown(event.key.keysym.sym);
                 }
             }
+            if (replaying) {
+                for (SDL_Keycode key : replayInput.Frame(replayFrame).pressed) handleKeyDown(key);
+            }
         }
 
         // Get current keyboard state for continuous movement
         const Uint8* keyState = SDL_GetKeyboardState(nullptr);
+        if (replaying) {
+            FillKeyState(replayInput.Frame(replayFrame), replayKeyState);
+            keyState = replayKeyState.data();
+        }
 
-        // Process player movement with debugging output
-        static Uint32 lastMovementTime = 0;
-        if (currentTime - lastMovementTime > 16) { // Cap at ~60 fps for movement
-            HandlePlayerMovement(player, keyState, deltaTime, world);
-            lastMovementTime = currentTime;
+        // Stream in chunks around the player before anything reads them this frame
+        if (streamWorld) {
+            chunkTerrain.Update(player.x, player.y);
         }
 
+        // Advance the simulation in fixed steps covering the real time since the last frame
+        {
+            ScopedPhaseTimer movementTimer(profiler, ProfilePhase::Movement);
+            // A replayed frame covers the same time as the recorded one, so it runs the same steps
+            const int steps = replaying ? simulationClock.AdvanceBy(replayInput.Frame(replayFrame++).seconds)
+                                        : simulationClock.Advance();
+            if (recordingInput) {
+                inputFrame.seconds = simulationClock.FrameSeconds();
+                CaptureHeldKeys(keyState, inputFrame);
+                recordedInput.Append(inputFrame);
+                inputFrame.pressed.clear();
+            }
+            for (int step = 0; step < steps; ++step) {
+                previousPlayer = player;
+                HandlePlayerMovement(player, keyState, static_cast<float>(simulationClock.StepSeconds()), terrain);
+                UpdateEntities(entities, static_cast<float>(simulationClock.StepSeconds()), terrain, &entityPool);
+            }
+        }
+
+        // Everything below draws the player between the last two simulation steps
+        const Player view = InterpolatePlayer(previousPlayer, player, simulationClock.Alpha());
+
         // Update camera to follow player
-        camera.update(player);
+        {
+            ScopedPhaseTimer cameraTimer(profiler, ProfilePhase::Camera);
+            camera.update(view, static_cast<float>(simulationClock.FrameSeconds()));
+        }
 
-        SDL_SetRenderDrawColor(renderer, 25, 25, 35, 255); // Dark blue-gray background
+        // Camera and player position for debugging, printed by the logger at debug level
+        cameraXGauge.Set(camera.x);
+        cameraYGauge.Set(camera.y);
+        playerXGauge.Set(player.x);
+        playerYGauge.Set(player.y);
+        playerElevationGauge.Set(player.elevation);
+
+        // Collect all visible tiles, then draw them with one geometry submission.
+        // Only the rows and columns that can reach the viewport are visited.
+        // Zoomed out far enough, a coarser LOD level stands in for the tiles; its camera
+        // and elevations are in that level's cell units.
+        const int lodLevel = terrainLod.LevelForZoom(camera.zoom);
+        const TerrainSource& drawTerrain = lodLevel == 0 ? terrain : terrainLod.Level(lodLevel);
+        const Camera drawCamera = TerrainLod::LevelCamera(camera, lodLevel);
+        // Skip or shortcut frames that would look like the last one drawn
+        FrameState frameState;
+        frameState.cameraX = camera.x;
+        frameState.cameraY = camera.y;
+        frameState.zoom = camera.zoom;
+        frameState.playerX = view.x;
+        frameState.playerY = view.y;
+        frameState.playerElevation = view.elevation;
+        frameState.lodLevel = lodLevel;
+        frameState.terrainRevision = terrainRevision + chunkTerrain.Revision();
+        frameState.debugMode = debugMode;
+        frameState.chunkTextures = useChunkTextures;
+        FrameChange change = frameSkip && hasDrawnFrame ? CompareFrames(drawnFrame, frameState) : FrameChange::Full;
+        if (change == FrameChange::None) {
+            if (PlayerAtRest(previousPlayer, player) && entities.AtRest() &&
+                camera.settled(view, FRAME_SKIP_TOLERANCE_PX)) {
+                // The last frame stays on screen. Nothing moves until input arrives, except
+                // streamed chunks, which are polled more often while some are pending.
+                skippedFramesCounter.Add();
+                const bool streaming = streamWorld && chunkTerrain.PendingCount() > 0;
+                SDL_WaitEventTimeout(nullptr, streaming ? IDLE_STREAM_WAIT_MS : IDLE_WAIT_MS);
+                simulationClock.Resync();
+                continue;
+            }
+            // Still easing in below the tolerance; keep presenting so the loop stays paced
+            change = FrameChange::PlayerOnly;
+        }
+
+        SDL_SetRenderDrawColor(renderer, background.r, background.g, background.b, background.a);
         SDL_RenderClear(renderer);
 
-        // Print camera and player position for debugging (only once per second)
-        static Uint32 lastDebugTime = 0;
-        if (currentTime - lastDebugTime > 1000) {
-            std::cout << "Camera: (" << camera.x << ", " << camera.y << ")" << std::endl;
-            std::cout << "Player: (" << player.x << ", " << player.y << ", " << player.elevation << ")" << std::endl;
-            lastDebugTime = currentTime;
-        }
-
-        // Simpler rendering approach to debug visibility
-        for (int y = 0; y < WORLD_HEIGHT; y++) {
-            for (int x = 0; x < WORLD_WIDTH; x++) {
-                // Only render tiles that are likely to be visible
-                int screenX, screenY;
-                WorldToScreen(x, y, world[y][x].elevation, screenX, screenY, camera, player);
-
-                // Check if the tile is potentially visible on screen (with margin)
-                if (screenX > -TILE_WIDTH && screenX < SCREEN_WIDTH + TILE_WIDTH &&
-                    screenY > -TILE_HEIGHT && screenY < SCREEN_HEIGHT + TILE_HEIGHT) {
-                    RenderTile(renderer, world[y][x], camera, player);
+        if (change == FrameChange::PlayerOnly && terrainFrame.Draw()) {
+            // The terrain is unchanged since the last capture; only the player and overlay
+            // are drawn over it
+            cachedFramesCounter.Add();
+        } else {
+            const bool capturing = frameSkip && terrainFrame.BeginCapture(background);
+            {
+                ScopedPhaseTimer cullingTimer(profiler, ProfilePhase::Culling);
+                // Visibility is centered on what the camera shows, which may trail the player
+                const float drawElevation = view.elevation / static_cast<float>(1 << lodLevel);
+                float centerX, centerY;
+                drawCamera.viewCenter(drawElevation, centerX, centerY);
+                ComputeVisibleTiles(centerX, centerY, drawElevation, drawTerrain.ElevationBounds(),
+                                    drawTerrain.Bounds(), visibleTiles, drawCamera.zoom);
+            }
+            {
+                ScopedPhaseTimer submissionTimer(profiler, ProfilePhase::Submission);
+                tileBatch.Clear();
+                if (useChunkTextures && lodLevel == 0) {
+                    // Baked blocks are copied directly; only tiles of blocks still streaming in
+                    // land in the batch
+                    ChunkTextureStats textureStats = chunkTextures.Draw(terrain, visibleTiles, camera, tileBatch);
+                    tileBatch.Draw(renderer);
+                    profiler.SetTileCounts(textureStats.tilesCovered + textureStats.fallbackTiles,
+                                           textureStats.tilesCovered + static_cast<int>(tileBatch.TileCount()));
+                } else {
+                    int tilesVisited = BatchVisibleTiles(drawTerrain, visibleTiles, drawCamera, tileBatch);
+                    tileBatch.Draw(renderer);
+                    profiler.SetTileCounts(tilesVisited, static_cast<int>(tileBatch.TileCount()));
                 }
             }
-        }
 
-        RenderPlayer(renderer, player, camera);
+            if (capturing) {
+                terrainFrame.EndCapture();
+            }
+            drawnFrame = frameState;
+        }
+        // Player-only frames move the player without moving the terrain baseline
+        drawnFrame.playerX = frameState.playerX;
+        drawnFrame.playerY = frameState.playerY;
+        drawnFrame.playerElevation = frameState.playerElevation;
+        hasDrawnFrame = true;
+
+        {
+            ScopedPhaseTimer playerTimer(profiler, ProfilePhase::Player);
+            entitiesDrawnGauge.Set(entityBatch.Build(entities, simulationClock.Alpha(), camera));
+            entityBatch.Draw(renderer);
+            RenderPlayer(renderer, view, camera);
+        }
 
         // Draw debug information on screen
         if (debugMode) {
+            ScopedPhaseTimer overlayTimer(profiler, ProfilePhase::Overlay);
+
             // Draw coordinate grid
             SDL_SetRenderDrawColor(renderer, 255, 255, 255, 100);
 
@@ -256,15 +652,53 @@ int main(int argc, char* argv[]) {
             SDL_SetRenderDrawColor(renderer, 0, 0, 255, 255);
             SDL_RenderDrawLine(renderer, 20, 65, 20 + zLineLength, 65);
 
-            // Also update window title with coordinates
-            char title[100];
-            snprintf(title, sizeof(title), "2.5D Lands - Player: X=%.1f, Y=%.1f, Z=%.1f", player.x, player.y, player.elevation);
+            // Frame profiler below the coordinate box
+            profiler.Draw(renderer, 10, 80);
+
+            // Also update window title with coordinates and the profiler averages
+            const FrameSample average = profiler.Average();
+            char title[160];
+            snprintf(title, sizeof(title), "2.5D Lands - Player: X=%.1f, Y=%.1f, Z=%.1f - %.2f ms, tiles %d/%d",
+                     player.x, player.y, player.elevation, average.frameMs, average.tilesDrawn, average.tilesVisited);
             SDL_SetWindowTitle(window, title);
         }
 
-        SDL_RenderPresent(renderer);
+        {
+            ScopedPhaseTimer presentTimer(profiler, ProfilePhase::Present);
+            SDL_RenderPresent(renderer);
+        }
+        profiler.EndFrame();
+        frameMsGauge.Set(profiler.Frame(0).frameMs);
+        tilesDrawnGauge.Set(profiler.Frame(0).tilesDrawn);
+        if (replaying) {
+            replayTimings.push_back(profiler.Frame(0));
+        }
     }
 
+    StopTelemetry();
+    if (recordingInput && recordedInput.Save(recordPath)) {
+        std::cout << "Recorded " << recordedInput.FrameCount() << " frames to " << recordPath << std::endl;
+    }
+    if (recordingInput || replaying) {
+        // A recording and its replays end in the same place; a different position means a
+        // run did not see the same input or world
+        std::cout << "Final player position: (" << player.x << ", " << player.y << ", " << player.elevation << ")"
+                  << std::endl;
+    }
+    if (replaying) {
+        std::cout << "Replayed " << replayTimings.size() << " frames" << std::endl;
+        if (reportPath.empty()) {
+            WriteFrameReport(replayTimings, std::cout);
+        } else {
+            std::ofstream report(reportPath);
+            WriteFrameReport(replayTimings, report);
+            if (report) {
+                std::cout << "Wrote frame report to " << reportPath << std::endl;
+            } else {
+                std::cerr << "Could not write " << reportPath << std::endl;
+            }
+        }
+    }
     SDL_DestroyRenderer(renderer);
     SDL_DestroyWindow(window);
     SDL_Quit();